@@ -0,0 +1,589 @@
+/** @file BasisPoly.cpp
+* Chebyshev, Legendre and Newton basis polynomials: Clenshaw evaluation, conversion to and from SparsePoly and arithmetic
+* within a basis.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "BasisPoly.h"
+#include <algorithm>
+#include <utility>
+
+// Constructor for the zero polynomial
+template <class ItemType>
+BasisPoly<ItemType>::BasisPoly(PolyBasis someBasis, char var) : basis(someBasis), variable(var)
+{ }  // End default constructor
+
+// Constructor from Chebyshev or Legendre coefficients
+template <class ItemType>
+BasisPoly<ItemType>::BasisPoly(PolyBasis someBasis, const std::vector<ItemType>& someCoefficients, char var)
+    : basis(someBasis), coefficients(someCoefficients), variable(var)
+{
+    if (basis == PolyBasis::Newton)
+    {
+        coefficients.resize(std::min<size_t>(coefficients.size(), 1)); // Without nodes only N_0 = 1 exists
+    } // End if
+    trim();
+}  // End coefficient constructor
+
+// Constructor from Newton coefficients and nodes
+template <class ItemType>
+BasisPoly<ItemType>::BasisPoly(const std::vector<ItemType>& someCoefficients, const std::vector<ItemType>& someNodes, char var)
+    : basis(PolyBasis::Newton), coefficients(someCoefficients), nodes(someNodes), variable(var)
+{
+    if (coefficients.size() > nodes.size() + 1)
+    {
+        coefficients.resize(nodes.size() + 1);
+    } // End if
+    trim();
+}  // End Newton constructor
+
+// Drops trailing zero coefficients
+template <class ItemType>
+void BasisPoly<ItemType>::trim()
+{
+    while (!coefficients.empty() && coefficients.back() == 0)
+    {
+        coefficients.pop_back();
+    } // End while
+}  // End trim
+
+// Checks that two polynomials can be combined coefficient by coefficient
+template <class ItemType>
+bool BasisPoly<ItemType>::isCompatible(const BasisPoly& other) const
+{
+    return basis == other.basis && variable == other.variable && nodes == other.nodes;
+}  // End isCompatible
+
+// Gives the three term recurrence of a basis
+template <class ItemType>
+void BasisPoly<ItemType>::recurrence(PolyBasis basis, const Dense& nodes, size_t k, ItemType& alpha, ItemType& beta, ItemType& gamma)
+{
+    beta = 0;
+    switch (basis)
+    {
+    case PolyBasis::Chebyshev:
+        // T_1 = x T_0, then T_(k+1) = 2x T_k - T_(k-1)
+        alpha = (k == 0) ? static_cast<ItemType>(1) : static_cast<ItemType>(2);
+        gamma = (k == 0) ? static_cast<ItemType>(0) : static_cast<ItemType>(1);
+        break;
+    case PolyBasis::Legendre:
+        // (k + 1) P_(k+1) = (2k + 1) x P_k - k P_(k-1)
+        alpha = static_cast<ItemType>(2 * k + 1) / static_cast<ItemType>(k + 1);
+        gamma = static_cast<ItemType>(k) / static_cast<ItemType>(k + 1);
+        break;
+    default:
+        // N_(k+1) = (x - x_k) N_k; past the last node the step never reaches a nonzero value
+        alpha = 1;
+        beta = (k < nodes.size()) ? -nodes[k] : static_cast<ItemType>(0);
+        gamma = 0;
+        break;
+    } // End switch
+}  // End recurrence
+
+// Multiplies a series in a basis by x
+template <class ItemType>
+void BasisPoly<ItemType>::multiplyByX(Dense& series, PolyBasis basis, const Dense& nodes)
+{
+    Dense product(series.size() + 1, static_cast<ItemType>(0));
+    ItemType alpha;
+    ItemType beta;
+    ItemType gamma;
+    for (size_t k = 0; k < series.size(); k++)
+    {
+        if (series[k] == 0)
+        {
+            continue;
+        } // End if
+        recurrence(basis, nodes, k, alpha, beta, gamma);
+        const ItemType scaled = series[k] / alpha;
+        product[k + 1] += scaled;
+        product[k] -= beta * scaled;
+        if (k > 0)
+        {
+            product[k - 1] += gamma * scaled;
+        } // End if
+    } // End for
+    series.swap(product);
+}  // End multiplyByX
+
+// Converts monomial coefficients to a basis with Horner's rule
+template <class ItemType>
+typename BasisPoly<ItemType>::Dense BasisPoly<ItemType>::fromMonomialQuadratic(const ItemType* monomial, size_t length,
+    PolyBasis basis, const Dense& nodes)
+{
+    Dense series;
+    for (size_t i = length; i > 0; i--)
+    {
+        if (!series.empty())
+        {
+            multiplyByX(series, basis, nodes);
+        }
+        else
+        {
+            series.push_back(static_cast<ItemType>(0));
+        } // End if
+        series[0] += monomial[i - 1];
+    } // End for
+    series.resize(length, static_cast<ItemType>(0));
+    return series;
+}  // End fromMonomialQuadratic
+
+// Multiplies two Chebyshev series
+template <class ItemType>
+typename BasisPoly<ItemType>::Dense BasisPoly<ItemType>::chebyshevProduct(const Dense& a, const Dense& b)
+{
+    if (a.empty() || b.empty())
+    {
+        return Dense();
+    } // End if
+    const ItemType half = static_cast<ItemType>(0.5);
+    Dense product = PolyKernels<ItemType>::multiply(a, b); // The T_(i+j) halves
+    for (ItemType& coefficient : product)
+    {
+        coefficient *= half;
+    } // End for
+
+    // Against the reversed a, position t collects the pairs with i - j = p - t, giving the T_|i-j| halves
+    const size_t p = a.size() - 1;
+    Dense reversed(a.rbegin(), a.rend());
+    Dense difference = PolyKernels<ItemType>::multiply(reversed, b);
+    for (size_t t = 0; t < difference.size(); t++)
+    {
+        product[(t <= p) ? p - t : t - p] += half * difference[t];
+    } // End for
+    return product;
+}  // End chebyshevProduct
+
+// Returns the Chebyshev series of x^m
+template <class ItemType>
+const typename BasisPoly<ItemType>::Dense& BasisPoly<ItemType>::chebyshevPowerOfX(size_t m, std::map<size_t, Dense>& powers)
+{
+    auto found = powers.find(m);
+    if (found != powers.end())
+    {
+        return found->second;
+    } // End if
+    Dense series;
+    if (m < CONVERSION_THRESHOLD)
+    {
+        Dense monomial(m + 1, static_cast<ItemType>(0));
+        monomial[m] = 1;
+        series = fromMonomialQuadratic(monomial.data(), monomial.size(), PolyBasis::Chebyshev, Dense());
+    }
+    else
+    {
+        const Dense& low = chebyshevPowerOfX(m / 2, powers);
+        series = chebyshevProduct(low, chebyshevPowerOfX(m - m / 2, powers));
+    } // End if
+    return powers.emplace(m, std::move(series)).first->second;
+}  // End chebyshevPowerOfX
+
+// Converts monomial coefficients to the Chebyshev basis by halves
+template <class ItemType>
+typename BasisPoly<ItemType>::Dense BasisPoly<ItemType>::chebyshevFromMonomial(const ItemType* monomial, size_t length,
+    std::map<size_t, Dense>& powers)
+{
+    if (length <= CONVERSION_THRESHOLD)
+    {
+        return fromMonomialQuadratic(monomial, length, PolyBasis::Chebyshev, Dense());
+    } // End if
+    const size_t m = length / 2;
+    Dense series = chebyshevFromMonomial(monomial, m, powers);
+    const Dense high = chebyshevFromMonomial(monomial + m, length - m, powers);
+    const Dense shifted = chebyshevProduct(high, chebyshevPowerOfX(m, powers));
+    series.resize(std::max(series.size(), shifted.size()), static_cast<ItemType>(0));
+    for (size_t k = 0; k < shifted.size(); k++)
+    {
+        series[k] += shifted[k];
+    } // End for
+    series.resize(length, static_cast<ItemType>(0));
+    return series;
+}  // End chebyshevFromMonomial
+
+// Builds the Clenshaw transfer map of a range of coefficients
+template <class ItemType>
+void BasisPoly<ItemType>::buildTransfer(size_t lo, size_t hi, bool needMatrix, Transfer& transfer) const
+{
+    ItemType alpha;
+    ItemType beta;
+    ItemType gamma;
+    if (hi - lo <= CONVERSION_THRESHOLD)
+    {
+        // Start from the identity map and apply the steps b_k = c_k + (alpha_k x + beta_k) b_(k+1) - gamma_(k+1) b_(k+2) downward
+        for (size_t i = 0; i < 2; i++)
+        {
+            transfer.shift[i].assign(1, static_cast<ItemType>(0));
+            for (size_t j = 0; j < 2; j++)
+            {
+                transfer.matrix[i][j].assign(1, static_cast<ItemType>(i == j ? 1 : 0));
+            } // End for
+        } // End for
+        const size_t columns = needMatrix ? 3 : 1; // Columns of the matrix, then the shift
+        for (size_t k = hi; k > lo; k--)
+        {
+            recurrence(basis, nodes, k - 1, alpha, beta, gamma);
+            ItemType nextGamma;
+            ItemType unused;
+            recurrence(basis, nodes, k, unused, unused, nextGamma);
+            for (size_t column = 3 - columns; column < 3; column++)
+            {
+                Dense& top = (column < 2) ? transfer.matrix[0][column] : transfer.shift[0];
+                Dense& bottom = (column < 2) ? transfer.matrix[1][column] : transfer.shift[1];
+                Dense next(top.size() + 1, static_cast<ItemType>(0));
+                for (size_t d = 0; d < top.size(); d++)
+                {
+                    next[d + 1] += alpha * top[d];
+                    next[d] += beta * top[d];
+                } // End for
+                for (size_t d = 0; d < bottom.size(); d++)
+                {
+                    next[d] -= nextGamma * bottom[d];
+                } // End for
+                if (column == 2)
+                {
+                    next[0] += coefficients[k - 1];
+                } // End if
+                bottom.swap(top);
+                top.swap(next);
+            } // End for
+        } // End for
+        return;
+    } // End if
+
+    // The left half maps the right half's output: matrix = left * right, shift = left * right shift + left shift
+    const size_t mid = lo + (hi - lo) / 2;
+    Transfer left;
+    Transfer right;
+    buildTransfer(lo, mid, true, left);
+    buildTransfer(mid, hi, needMatrix, right);
+    const size_t columns = needMatrix ? 3 : 1;
+    for (size_t i = 0; i < 2; i++)
+    {
+        for (size_t column = 3 - columns; column < 3; column++)
+        {
+            const Dense& rightTop = (column < 2) ? right.matrix[0][column] : right.shift[0];
+            const Dense& rightBottom = (column < 2) ? right.matrix[1][column] : right.shift[1];
+            Dense sum = PolyKernels<ItemType>::multiply(left.matrix[i][0], rightTop);
+            const Dense second = PolyKernels<ItemType>::multiply(left.matrix[i][1], rightBottom);
+            const Dense& extra = (column < 2) ? Dense() : left.shift[i];
+            sum.resize(std::max(sum.size(), std::max(second.size(), extra.size())), static_cast<ItemType>(0));
+            for (size_t d = 0; d < second.size(); d++)
+            {
+                sum[d] += second[d];
+            } // End for
+            for (size_t d = 0; d < extra.size(); d++)
+            {
+                sum[d] += extra[d];
+            } // End for
+            ((column < 2) ? transfer.matrix[i][column] : transfer.shift[i]).swap(sum);
+        } // End for
+    } // End for
+}  // End buildTransfer
+
+// Converts a monomial polynomial to a basis
+template <class ItemType>
+BasisPoly<ItemType> BasisPoly<ItemType>::fromMonomial(const SparsePoly<ItemType>& poly, PolyBasis someBasis, const std::vector<ItemType>& someNodes)
+{
+    BasisPoly<ItemType> result(someBasis, poly.getVariable());
+    if (someBasis == PolyBasis::Newton)
+    {
+        result.nodes = someNodes;
+    } // End if
+    if (poly.isEmpty())
+    {
+        return result;
+    } // End if
+    const Dense monomial = poly.toDenseCoefficients();
+    switch (someBasis)
+    {
+    case PolyBasis::Chebyshev:
+    {
+        std::map<size_t, Dense> powers;
+        result.coefficients = chebyshevFromMonomial(monomial.data(), monomial.size(), powers);
+        break;
+    }
+    case PolyBasis::Legendre:
+        result.coefficients = fromMonomialQuadratic(monomial.data(), monomial.size(), someBasis, result.nodes);
+        break;
+    default:
+        if (result.nodes.size() + 1 < monomial.size())
+        {
+            return result; // Too few nodes for the degree
+        } // End if
+        result.coefficients = fromMonomialQuadratic(monomial.data(), monomial.size(), someBasis, result.nodes);
+        break;
+    } // End switch
+    result.trim();
+    return result;
+}  // End fromMonomial
+
+// Converts the polynomial to monomial form
+template <class ItemType>
+SparsePoly<ItemType> BasisPoly<ItemType>::toMonomial() const
+{
+    SparsePoly<ItemType> result(variable);
+    if (coefficients.empty())
+    {
+        return result;
+    } // End if
+    // With b_(n+1) = b_(n+2) = 0 the value is b_0, the first entry of the shift of the whole range
+    Transfer transfer;
+    buildTransfer(0, coefficients.size(), false, transfer);
+    result.assignDenseCoefficients(transfer.shift[0]);
+    return result;
+}  // End toMonomial
+
+// Updates the coefficient of one basis polynomial
+template <class ItemType>
+int BasisPoly<ItemType>::changeCoefficient(ItemType newCoefficient, unsigned int index)
+{
+    if (basis == PolyBasis::Newton && index > nodes.size())
+    {
+        return -1;
+    } // End if
+    if (index >= coefficients.size())
+    {
+        if (newCoefficient == 0)
+        {
+            return 0;
+        } // End if
+        coefficients.resize(static_cast<size_t>(index) + 1, static_cast<ItemType>(0));
+    } // End if
+    coefficients[index] = newCoefficient;
+    trim();
+    return 0;
+}  // End changeCoefficient
+
+// Returns the coefficient of one basis polynomial
+template <class ItemType>
+ItemType BasisPoly<ItemType>::coefficient(unsigned int index) const
+{
+    return (index < coefficients.size()) ? coefficients[index] : static_cast<ItemType>(0);
+}  // End coefficient
+
+// Returns the degree of the polynomial
+template <class ItemType>
+unsigned int BasisPoly<ItemType>::degree() const
+{
+    return static_cast<unsigned int>(coefficients.size()) - 1; // -1 when empty
+}  // End degree
+
+// Displays the polynomial as a sum of basis polynomials
+template <class ItemType>
+std::string BasisPoly<ItemType>::displayPoly() const
+{
+    if (coefficients.empty())
+    {
+        return std::string("0");
+    } // End if
+    const char name = (basis == PolyBasis::Chebyshev) ? 'T' : (basis == PolyBasis::Legendre) ? 'P' : 'N';
+    std::string polyString;
+    for (size_t k = coefficients.size(); k > 0; k--)
+    {
+        if (coefficients[k - 1] == 0)
+        {
+            continue;
+        } // End if
+        if (!polyString.empty())
+        {
+            polyString += " + ";
+        } // End if
+        polyString += "(" + std::to_string(coefficients[k - 1]) + ")" + name + "_" + std::to_string(k - 1) + "(" + variable + ")";
+    } // End for
+    return polyString;
+}  // End displayPoly
+
+// Checks if the polynomial is zero
+template <class ItemType>
+bool BasisPoly<ItemType>::isEmpty() const
+{
+    return coefficients.empty();
+}  // End isEmpty
+
+// Returns the variable character
+template <class ItemType>
+char BasisPoly<ItemType>::getVariable() const
+{
+    return variable;
+}  // End getVariable
+
+// Returns the basis
+template <class ItemType>
+PolyBasis BasisPoly<ItemType>::getBasis() const
+{
+    return basis;
+}  // End getBasis
+
+// Returns the Newton nodes
+template <class ItemType>
+const std::vector<ItemType>& BasisPoly<ItemType>::getNodes() const
+{
+    return nodes;
+}  // End getNodes
+
+// Evaluates with Clenshaw's recurrence
+template <class ItemType>
+ItemType BasisPoly<ItemType>::evaluate(ItemType x) const
+{
+    ItemType alpha;
+    ItemType beta;
+    ItemType gamma;
+    ItemType nextGamma = 0; // gamma_(k+1), which multiplies b_(k+2)
+    ItemType b1 = 0;
+    ItemType b2 = 0;
+    for (size_t k = coefficients.size(); k > 0; k--)
+    {
+        recurrence(basis, nodes, k - 1, alpha, beta, gamma);
+        const ItemType b0 = coefficients[k - 1] + (alpha * x + beta) * b1 - nextGamma * b2;
+        b2 = b1;
+        b1 = b0;
+        nextGamma = gamma;
+    } // End for
+    return b1;
+}  // End evaluate
+
+// Evaluates at many points, several points per pass over the coefficients
+template <class ItemType>
+std::vector<ItemType> BasisPoly<ItemType>::evaluateMany(const std::vector<ItemType>& points) const
+{
+    const size_t n = coefficients.size();
+    std::vector<ItemType> values(points.size(), static_cast<ItemType>(0));
+    if (n == 0)
+    {
+        return values;
+    } // End if
+
+    // Recurrence coefficients of step k, with gamma shifted so step k reads gamma_(k+1)
+    std::vector<ItemType> alphas(n);
+    std::vector<ItemType> betas(n);
+    std::vector<ItemType> nextGammas(n, static_cast<ItemType>(0));
+    ItemType gamma;
+    for (size_t k = 0; k < n; k++)
+    {
+        recurrence(basis, nodes, k, alphas[k], betas[k], gamma);
+        if (k > 0)
+        {
+            nextGammas[k - 1] = gamma;
+        } // End if
+    } // End for
+
+    for (size_t start = 0; start < points.size(); start += EVALUATION_LANES)
+    {
+        const size_t lanes = std::min(EVALUATION_LANES, points.size() - start);
+        ItemType x[EVALUATION_LANES] = {};
+        ItemType b1[EVALUATION_LANES] = {};
+        ItemType b2[EVALUATION_LANES] = {};
+        for (size_t lane = 0; lane < lanes; lane++)
+        {
+            x[lane] = points[start + lane];
+        } // End for
+        for (size_t k = n; k > 0; k--)
+        {
+            const ItemType c = coefficients[k - 1];
+            const ItemType alpha = alphas[k - 1];
+            const ItemType beta = betas[k - 1];
+            const ItemType g = nextGammas[k - 1];
+            // Full width every step so the loop has a fixed trip count; unused lanes compute on 0
+            for (size_t lane = 0; lane < EVALUATION_LANES; lane++)
+            {
+                const ItemType b0 = c + (alpha * x[lane] + beta) * b1[lane] - g * b2[lane];
+                b2[lane] = b1[lane];
+                b1[lane] = b0;
+            } // End for
+        } // End for
+        for (size_t lane = 0; lane < lanes; lane++)
+        {
+            values[start + lane] = b1[lane];
+        } // End for
+    } // End for
+    return values;
+}  // End evaluateMany
+
+// Adds two polynomials in the same basis
+template <class ItemType>
+BasisPoly<ItemType> BasisPoly<ItemType>::add(const BasisPoly<ItemType>& anotherPoly) const
+{
+    if (!isCompatible(anotherPoly))
+    {
+        return BasisPoly<ItemType>();
+    } // End if
+    BasisPoly<ItemType> result(*this);
+    result.coefficients.resize(std::max(coefficients.size(), anotherPoly.coefficients.size()), static_cast<ItemType>(0));
+    for (size_t k = 0; k < anotherPoly.coefficients.size(); k++)
+    {
+        result.coefficients[k] += anotherPoly.coefficients[k];
+    } // End for
+    result.trim();
+    return result;
+}  // End add
+
+// Multiplies the polynomial by a scalar
+template <class ItemType>
+BasisPoly<ItemType> BasisPoly<ItemType>::scalarMultiply(ItemType scalar) const
+{
+    BasisPoly<ItemType> result(*this);
+    for (ItemType& coefficient : result.coefficients)
+    {
+        coefficient *= scalar;
+    } // End for
+    result.trim();
+    return result;
+}  // End scalarMultiply
+
+// Multiplies two Chebyshev series
+template <class ItemType>
+BasisPoly<ItemType> BasisPoly<ItemType>::multiply(const BasisPoly<ItemType>& anotherPoly) const
+{
+    if (basis != PolyBasis::Chebyshev || !isCompatible(anotherPoly))
+    {
+        return BasisPoly<ItemType>();
+    } // End if
+    return BasisPoly<ItemType>(PolyBasis::Chebyshev, chebyshevProduct(coefficients, anotherPoly.coefficients), variable);
+}  // End multiply
+
+// Differentiates a Chebyshev or Legendre series
+template <class ItemType>
+BasisPoly<ItemType> BasisPoly<ItemType>::derivative() const
+{
+    if (basis == PolyBasis::Newton)
+    {
+        return BasisPoly<ItemType>();
+    } // End if
+    BasisPoly<ItemType> result(basis, variable);
+    if (coefficients.size() < 2)
+    {
+        return result;
+    } // End if
+    const size_t n = coefficients.size() - 1;
+    Dense derived(n + 2, static_cast<ItemType>(0)); // Two spare entries so index k + 1 is always valid
+    for (size_t k = n; k > 0; k--)
+    {
+        if (basis == PolyBasis::Chebyshev)
+        {
+            // d_(k-1) = d_(k+1) + 2k c_k, with d_0 halved at the end
+            derived[k - 1] = derived[k + 1] + static_cast<ItemType>(2 * k) * coefficients[k];
+        }
+        else
+        {
+            // d_j = (2j + 1)(c_(j+1) + c_(j+3) + ...); derived holds the sums until they are scaled
+            derived[k - 1] = derived[k + 1] + coefficients[k];
+        } // End if
+    } // End for
+    if (basis == PolyBasis::Chebyshev)
+    {
+        derived[0] *= static_cast<ItemType>(0.5);
+    }
+    else
+    {
+        for (size_t j = 0; j < n; j++)
+        {
+            derived[j] *= static_cast<ItemType>(2 * j + 1);
+        } // End for
+    } // End if
+    derived.resize(n);
+    result.coefficients.swap(derived);
+    result.trim();
+    return result;
+}  // End derivative
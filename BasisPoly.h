@@ -0,0 +1,233 @@
+/** @file BasisPoly.h
+* @class BasisPoly
+* Dense polynomial held in a basis other than the monomials: Chebyshev polynomials T_k, Legendre polynomials P_k or the
+* Newton basis N_k(x) = (x - x_0)(x - x_1)...(x - x_(k-1)) over a list of nodes. Each basis follows a three term
+* recurrence P_(k+1) = (alpha_k x + beta_k) P_k - gamma_k P_(k-1), so values come from Clenshaw's recurrence without ever
+* forming the monomial coefficients, which keeps evaluation stable for the Chebyshev and Legendre bases on [-1, 1].
+*
+* Conversion to a SparsePoly runs Clenshaw's recurrence on polynomials, splitting the coefficients in halves and combining
+* the 2 x 2 transfer matrices of the halves, so the cost follows the multiplication kernel. Conversion from a SparsePoly
+* splits p = low + x^m * high for the Chebyshev basis, whose products reduce to two convolutions. The Legendre and Newton
+* bases convert with a quadratic Horner scheme; splitting by division by N_m is fast but loses all accuracy in floating
+* point once the degree reaches about 100.
+*/
+
+#ifndef BASIS_POLY_
+#define BASIS_POLY_
+
+#include "SparsePoly.h"
+#include "PolyKernels.h"
+#include <cstddef>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/** Bases a BasisPoly can be held in. */
+enum class PolyBasis
+{
+    Chebyshev,
+    Legendre,
+    Newton
+};
+
+template <class ItemType>
+class BasisPoly
+{
+    static_assert(std::is_floating_point<ItemType>::value, "BasisPoly requires a floating point coefficient type");
+
+private:
+    /** Number of coefficients below which conversions use the quadratic kernels. */
+    static constexpr size_t CONVERSION_THRESHOLD = 32;
+
+    /** Number of points evaluateMany runs through Clenshaw's recurrence side by side. */
+    static constexpr size_t EVALUATION_LANES = 8;
+
+    /** Dense coefficients, lowest power or lowest basis index first. */
+    using Dense = std::vector<ItemType>;
+
+    /** Affine map taking (b_hi, b_(hi+1)) of Clenshaw's recurrence to (b_lo, b_(lo+1)) for a range of coefficients, with
+    * polynomial entries: (b_lo, b_(lo+1)) = matrix * (b_hi, b_(hi+1)) + shift. */
+    struct Transfer
+    {
+        Dense matrix[2][2];
+        Dense shift[2];
+    };
+
+    /** Basis the coefficients refer to. */
+    PolyBasis basis;
+
+    /** coefficients[k] multiplies the basis polynomial of index k; there are no trailing zeros. */
+    Dense coefficients;
+
+    /** Nodes of the Newton basis, empty for the other bases. */
+    Dense nodes;
+
+    /** Character for polynomial variable, default is 'x'. */
+    char variable;
+
+    /** Drops trailing zero coefficients. */
+    void trim();
+
+    /** @return True if both polynomials use the same basis, nodes and variable. */
+    bool isCompatible(const BasisPoly& other) const;
+
+    /** Helper that gives the recurrence P_(k+1) = (alpha x + beta) P_k - gamma P_(k-1) of a basis.
+    * @param basis The basis.
+    * @param nodes Newton nodes.
+    * @param k Index of the recurrence step.
+    * @param alpha Receives the factor of x P_k.
+    * @param beta Receives the factor of P_k.
+    * @param gamma Receives the factor of P_(k-1). */
+    static void recurrence(PolyBasis basis, const Dense& nodes, size_t k, ItemType& alpha, ItemType& beta, ItemType& gamma);
+
+    /** Helper that multiplies a series in a basis by x, using x P_k = (P_(k+1) - beta_k P_k + gamma_k P_(k-1)) / alpha_k.
+    * @post series holds one more coefficient. */
+    static void multiplyByX(Dense& series, PolyBasis basis, const Dense& nodes);
+
+    /** Helper that converts dense monomial coefficients to a basis with Horner's rule, multiplying by x in the basis.
+    * @param monomial The monomial coefficients.
+    * @param length Number of coefficients.
+    * @return The coefficients in the basis, length of them. */
+    static Dense fromMonomialQuadratic(const ItemType* monomial, size_t length, PolyBasis basis, const Dense& nodes);
+
+    /** Helper that multiplies two Chebyshev series with T_i T_j = (T_(i+j) + T_|i-j|) / 2, as one convolution and one
+    * convolution against the reversed first operand. */
+    static Dense chebyshevProduct(const Dense& a, const Dense& b);
+
+    /** Helper that returns the Chebyshev series of x^m, built by products of smaller powers and kept in powers. */
+    static const Dense& chebyshevPowerOfX(size_t m, std::map<size_t, Dense>& powers);
+
+    /** Helper that converts dense monomial coefficients to the Chebyshev basis by splitting p = low + x^m * high. */
+    static Dense chebyshevFromMonomial(const ItemType* monomial, size_t length, std::map<size_t, Dense>& powers);
+
+    /** Helper that builds the Clenshaw transfer map of the coefficients in [lo, hi).
+    * @param needMatrix Whether the matrix is wanted; the shift is always computed.
+    * @param transfer Receives the map. */
+    void buildTransfer(size_t lo, size_t hi, bool needMatrix, Transfer& transfer) const;
+
+public:
+    /** Constructor for the zero polynomial in a basis. The Newton basis has no nodes; use the node constructor for it.
+    * @pre None
+    * @post None */
+    BasisPoly(PolyBasis someBasis = PolyBasis::Chebyshev, char var = 'x');
+
+    /** Constructor from coefficients in the Chebyshev or Legendre basis.
+    * @pre someBasis is not PolyBasis::Newton.
+    * @post None
+    * @param someBasis The basis.
+    * @param someCoefficients someCoefficients[k] multiplies the basis polynomial of index k.
+    * @param var The variable. */
+    BasisPoly(PolyBasis someBasis, const std::vector<ItemType>& someCoefficients, char var = 'x');
+
+    /** Constructor from coefficients in the Newton basis over given nodes.
+    * @pre None
+    * @post Coefficients beyond index nodes.size() are dropped, since the basis needs k nodes for index k.
+    * @param someCoefficients someCoefficients[k] multiplies N_k.
+    * @param someNodes The nodes x_0, x_1, ...
+    * @param var The variable. */
+    BasisPoly(const std::vector<ItemType>& someCoefficients, const std::vector<ItemType>& someNodes, char var = 'x');
+
+    /** Converts a monomial polynomial to a basis. Dense inputs convert in a number of steps that follows the multiplication
+    * kernel for the Chebyshev basis, and quadratic for the Legendre and Newton bases.
+    * @pre None
+    * @post None
+    * @param poly The polynomial.
+    * @param someBasis The basis to convert to.
+    * @param someNodes Nodes of the Newton basis, at least the degree of poly of them; ignored by the other bases.
+    * @return The polynomial in the basis, or an empty polynomial in the basis if there are too few Newton nodes. */
+    static BasisPoly fromMonomial(const SparsePoly<ItemType>& poly, PolyBasis someBasis, const std::vector<ItemType>& someNodes = std::vector<ItemType>());
+
+    /** Converts the polynomial to monomial form.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The SparsePoly with the same values and variable. */
+    SparsePoly<ItemType> toMonomial() const;
+
+    /** Updates the coefficient of one basis polynomial. A 0 coefficient removes it.
+    * @pre None
+    * @post The coefficient is updated.
+    * @param newCoefficient The new coefficient.
+    * @param index The index of the basis polynomial.
+    * @return 0 on success, or -1 if the Newton basis has too few nodes for the index. */
+    int changeCoefficient(ItemType newCoefficient, unsigned int index);
+
+    /** Returns the coefficient of one basis polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param index The index of the basis polynomial.
+    * @return The coefficient, or 0 past the degree. */
+    ItemType coefficient(unsigned int index) const;
+
+    /** Retrieves the degree of the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The highest index with a nonzero coefficient, or -1 if the polynomial is empty. */
+    unsigned int degree() const;
+
+    /** Displays the polynomial as a sum of basis polynomials, written T_k(x), P_k(x) or N_k(x).
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A string of the polynomial, or '0' if the polynomial is empty. */
+    std::string displayPoly() const;
+
+    /** Checks if polynomial contains terms.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return True if every coefficient is 0. */
+    bool isEmpty() const;
+
+    /** @return The variable character. */
+    char getVariable() const;
+
+    /** @return The basis of the coefficients. */
+    PolyBasis getBasis() const;
+
+    /** @return The Newton nodes, empty for the other bases. */
+    const std::vector<ItemType>& getNodes() const;
+
+    /** Evaluates the polynomial with Clenshaw's recurrence.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param x The value given for the variable.
+    * @return The value of the polynomial at x. */
+    ItemType evaluate(ItemType x) const;
+
+    /** Evaluates the polynomial at many points. The recurrence coefficients are computed once and the points run through
+    * the recurrence in groups of EVALUATION_LANES, a loop the compiler turns into vector instructions.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param points The values given for the variable.
+    * @return The value at each point, equal to evaluate at that point. */
+    std::vector<ItemType> evaluateMany(const std::vector<ItemType>& points) const;
+
+    /** Adds another polynomial in the same basis, coefficient by coefficient.
+    * @pre Both polynomials use the same basis, nodes and variable.
+    * @post Does not change the original polynomial.
+    * @param anotherPoly Is the other polynomial.
+    * @return The sum, or an empty polynomial if the bases, nodes or variables differ. */
+    BasisPoly add(const BasisPoly& anotherPoly) const;
+
+    /** Multiplies the polynomial by a scalar.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param scalar The value multiplied with the polynomial.
+    * @return The scaled polynomial. */
+    BasisPoly scalarMultiply(ItemType scalar) const;
+
+    /** Multiplies two Chebyshev series without leaving the basis, with two convolutions on the multiplication kernel.
+    * @pre Both polynomials are in the Chebyshev basis with the same variable.
+    * @post Does not change the original polynomial.
+    * @param anotherPoly Is the other polynomial.
+    * @return The product, or an empty polynomial for other bases or different variables. */
+    BasisPoly multiply(const BasisPoly& anotherPoly) const;
+
+    /** Differentiates a Chebyshev or Legendre series without leaving the basis, in one pass from the highest index down.
+    * @pre The polynomial is in the Chebyshev or Legendre basis.
+    * @post Does not change the original polynomial.
+    * @return The derivative, or an empty polynomial in the Newton basis. */
+    BasisPoly derivative() const;
+}; // end BasisPoly
+
+#include "BasisPoly.cpp"
+#endif
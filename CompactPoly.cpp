@@ -0,0 +1,404 @@
+/** @file CompactPoly.cpp
+* Frozen sparse polynomial packed into a single buffer of narrowed coefficients and delta encoded powers.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "CompactPoly.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+template <class ItemType>
+template <class Stored>
+bool CompactPoly<ItemType>::inRange(ItemType value, std::true_type)
+{
+    // NaN fails both tests and keeps the full width
+    return std::isinf(value) || (value <= std::numeric_limits<Stored>::max() && value >= -std::numeric_limits<Stored>::max());
+}  // End inRange
+
+template <class ItemType>
+template <class Stored>
+bool CompactPoly<ItemType>::inRange(ItemType, std::false_type)
+{
+    return true;
+}  // End inRange
+
+template <class ItemType>
+template <class Stored>
+bool CompactPoly<ItemType>::roundTrips(ItemType value)
+{
+    return inRange<Stored>(value, std::is_floating_point<ItemType>()) && static_cast<ItemType>(static_cast<Stored>(value)) == value;
+}  // End roundTrips
+
+template <class ItemType>
+bool CompactPoly<ItemType>::fitsWidth(ItemType value, unsigned char width)
+{
+    switch (width)
+    {
+    case 1:
+        return roundTrips<Narrow8>(value);
+    case 2:
+        return roundTrips<Narrow16>(value);
+    case 4:
+        return roundTrips<Narrow32>(value);
+    case 8:
+        return roundTrips<Narrow64>(value);
+    default:
+        return true;
+    } // End switch
+}  // End fitsWidth
+
+template <class ItemType>
+unsigned char CompactPoly<ItemType>::chooseWidth(const std::vector<Node<ItemType>>& terms)
+{
+    const unsigned char candidates[] = { 1, 2, 4, 8 };
+    for (unsigned char width : candidates)
+    {
+        // Floating point coefficients are never squeezed below a float
+        if (width >= sizeof(ItemType) || (std::is_floating_point<ItemType>::value && width < sizeof(float)))
+        {
+            continue;
+        } // End if
+        bool fits = true;
+        for (size_t i = 0; i < terms.size() && fits; i++)
+        {
+            fits = fitsWidth(terms[i].getCoefficient(), width);
+        } // End for
+        if (fits)
+        {
+            return width;
+        } // End if
+    } // End for
+    return static_cast<unsigned char>(sizeof(ItemType));
+}  // End chooseWidth
+
+template <class ItemType>
+void CompactPoly<ItemType>::writeCoefficient(unsigned char* target, ItemType value, unsigned char width)
+{
+    switch (width)
+    {
+    case 1:
+    {
+        Narrow8 stored = static_cast<Narrow8>(value);
+        std::memcpy(target, &stored, sizeof(stored));
+        break;
+    }
+    case 2:
+    {
+        Narrow16 stored = static_cast<Narrow16>(value);
+        std::memcpy(target, &stored, sizeof(stored));
+        break;
+    }
+    case 4:
+    {
+        Narrow32 stored = static_cast<Narrow32>(value);
+        std::memcpy(target, &stored, sizeof(stored));
+        break;
+    }
+    case 8:
+    {
+        Narrow64 stored = static_cast<Narrow64>(value);
+        std::memcpy(target, &stored, sizeof(stored));
+        break;
+    }
+    default:
+        std::memcpy(target, &value, sizeof(value));
+        break;
+    } // End switch
+}  // End writeCoefficient
+
+template <class ItemType>
+ItemType CompactPoly<ItemType>::coefficientAt(size_t index) const
+{
+    const unsigned char* source = buffer.data() + index * coefficientWidth;
+    switch (coefficientWidth)
+    {
+    case 1:
+    {
+        Narrow8 stored;
+        std::memcpy(&stored, source, sizeof(stored));
+        return static_cast<ItemType>(stored);
+    }
+    case 2:
+    {
+        Narrow16 stored;
+        std::memcpy(&stored, source, sizeof(stored));
+        return static_cast<ItemType>(stored);
+    }
+    case 4:
+    {
+        Narrow32 stored;
+        std::memcpy(&stored, source, sizeof(stored));
+        return static_cast<ItemType>(stored);
+    }
+    case 8:
+    {
+        Narrow64 stored;
+        std::memcpy(&stored, source, sizeof(stored));
+        return static_cast<ItemType>(stored);
+    }
+    default:
+    {
+        ItemType stored;
+        std::memcpy(&stored, source, sizeof(stored));
+        return stored;
+    }
+    } // End switch
+}  // End coefficientAt
+
+// Seven bits per byte, low bits first; the high bit marks that another byte follows
+template <class ItemType>
+void CompactPoly<ItemType>::writeVarint(std::vector<unsigned char>& stream, unsigned int value)
+{
+    while (value >= 0x80)
+    {
+        stream.push_back(static_cast<unsigned char>(value | 0x80));
+        value >>= 7;
+    } // End while
+    stream.push_back(static_cast<unsigned char>(value));
+}  // End writeVarint
+
+template <class ItemType>
+unsigned int CompactPoly<ItemType>::readVarint(const unsigned char*& position)
+{
+    unsigned int value = 0;
+    unsigned int shift = 0;
+    while (*position & 0x80)
+    {
+        value |= static_cast<unsigned int>(*position & 0x7F) << shift;
+        shift += 7;
+        position++;
+    } // End while
+    value |= static_cast<unsigned int>(*position) << shift;
+    position++;
+    return value;
+}  // End readVarint
+
+template <class ItemType>
+size_t CompactPoly<ItemType>::checkpointCount() const
+{
+    return (termCount + CHECKPOINT_SPACING - 1) / CHECKPOINT_SPACING;
+}  // End checkpointCount
+
+template <class ItemType>
+const unsigned char* CompactPoly<ItemType>::checkpoints() const
+{
+    return buffer.data() + termCount * coefficientWidth;
+}  // End checkpoints
+
+template <class ItemType>
+const unsigned char* CompactPoly<ItemType>::powerStream() const
+{
+    return checkpoints() + checkpointCount() * CHECKPOINT_BYTES;
+}  // End powerStream
+
+// Default constructor
+template <class ItemType>
+CompactPoly<ItemType>::CompactPoly() : termCount(0), coefficientWidth(static_cast<unsigned char>(sizeof(ItemType))), variable('x')
+{ }  // End default constructor
+
+template <class ItemType>
+CompactPoly<ItemType>::CompactPoly(const SparsePoly<ItemType>& other)
+    : termCount(0), coefficientWidth(static_cast<unsigned char>(sizeof(ItemType))), variable(other.getVariable())
+{
+    std::vector<Node<ItemType>> terms;
+    terms.reserve(static_cast<size_t>(other.getTermCount()));
+    other.forEachTerm([&terms](const ItemType& coefficient, unsigned int power)
+    {
+        terms.push_back(Node<ItemType>(coefficient, power));
+    });
+    if (terms.empty())
+    {
+        return;
+    } // End if
+    termCount = terms.size();
+    coefficientWidth = chooseWidth(terms);
+
+    // Encode the powers first so the buffer can be allocated once at its exact size
+    std::vector<unsigned char> stream;
+    std::vector<std::uint32_t> table;
+    stream.reserve(termCount + 4);
+    table.reserve(2 * checkpointCount());
+    unsigned int previous = 0;
+    for (size_t i = 0; i < termCount; i++)
+    {
+        unsigned int power = terms[i].getPower();
+        writeVarint(stream, (i == 0) ? power : previous - power);
+        if (i % CHECKPOINT_SPACING == 0)
+        {
+            table.push_back(static_cast<std::uint32_t>(power));
+            table.push_back(static_cast<std::uint32_t>(stream.size()));
+        } // End if
+        previous = power;
+    } // End for
+
+    const size_t coefficientBytes = termCount * coefficientWidth;
+    const size_t tableBytes = table.size() * sizeof(std::uint32_t);
+    buffer.resize(coefficientBytes + tableBytes + stream.size());
+    for (size_t i = 0; i < termCount; i++)
+    {
+        writeCoefficient(buffer.data() + i * coefficientWidth, terms[i].getCoefficient(), coefficientWidth);
+    } // End for
+    std::memcpy(buffer.data() + coefficientBytes, table.data(), tableBytes);
+    std::memcpy(buffer.data() + coefficientBytes + tableBytes, stream.data(), stream.size());
+}  // End conversion constructor
+
+template <class ItemType>
+std::vector<CompactPoly<ItemType>> CompactPoly<ItemType>::compactAll(const std::vector<SparsePoly<ItemType>>& polys)
+{
+    std::vector<CompactPoly> result;
+    result.reserve(polys.size());
+    for (const SparsePoly<ItemType>& poly : polys)
+    {
+        result.push_back(CompactPoly(poly));
+    } // End for
+    return result;
+}  // End compactAll
+
+// Finds the last checkpoint at or above the power, then decodes at most CHECKPOINT_SPACING terms from there
+template <class ItemType>
+ItemType CompactPoly<ItemType>::coefficient(unsigned int power) const
+{
+    POLY_INSTRUMENT_OPERATION(Coefficient);
+    const unsigned char* table = checkpoints();
+    size_t low = 0;
+    size_t high = checkpointCount();
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        std::uint32_t checkpointPower;
+        std::memcpy(&checkpointPower, table + middle * CHECKPOINT_BYTES, sizeof(checkpointPower));
+        if (checkpointPower >= power)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        } // End if
+    } // End while
+    if (low == 0)
+    {
+        return 0;
+    } // End if
+
+    const size_t checkpoint = low - 1;
+    std::uint32_t current;
+    std::uint32_t offset;
+    std::memcpy(&current, table + checkpoint * CHECKPOINT_BYTES, sizeof(current));
+    std::memcpy(&offset, table + checkpoint * CHECKPOINT_BYTES + sizeof(current), sizeof(offset));
+    const unsigned char* position = powerStream() + offset;
+    size_t index = checkpoint * CHECKPOINT_SPACING;
+    const size_t end = (index + CHECKPOINT_SPACING < termCount) ? index + CHECKPOINT_SPACING : termCount;
+    while (true)
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        if (current == power)
+        {
+            return coefficientAt(index);
+        } // End if
+        index++;
+        if (current < power || index == end)
+        {
+            return 0;
+        } // End if
+        current -= readVarint(position);
+    } // End while
+}  // End coefficient
+
+template <class ItemType>
+ItemType CompactPoly<ItemType>::evaluate(ItemType x) const
+{
+    POLY_INSTRUMENT_OPERATION(Evaluate);
+    if (termCount == 0)
+    {
+        return 0;
+    } // End if
+    const unsigned char* position = powerStream();
+    unsigned int power = readVarint(position);
+    ItemType result = coefficientAt(0);
+    for (size_t i = 1; i < termCount; i++)
+    {
+        unsigned int gap = readVarint(position);
+        result = result * PolyKernels<ItemType>::power(x, gap) + coefficientAt(i);
+        power -= gap;
+    } // End for
+    return result * PolyKernels<ItemType>::power(x, power);
+}  // End evaluate
+
+template <class ItemType>
+unsigned int CompactPoly<ItemType>::degree() const
+{
+    if (termCount == 0)
+    {
+        return static_cast<unsigned int>(-1);
+    } // End if
+    std::uint32_t power;
+    std::memcpy(&power, checkpoints(), sizeof(power));
+    return power;
+}  // End degree
+
+template <class ItemType>
+bool CompactPoly<ItemType>::isEmpty() const
+{
+    return termCount == 0;
+}  // End isEmpty
+
+template <class ItemType>
+char CompactPoly<ItemType>::getVariable() const
+{
+    return variable;
+}  // End getVariable
+
+template <class ItemType>
+int CompactPoly<ItemType>::getTermCount() const
+{
+    return static_cast<int>(termCount);
+}  // End getTermCount
+
+template <class ItemType>
+size_t CompactPoly<ItemType>::getCoefficientWidth() const
+{
+    return coefficientWidth;
+}  // End getCoefficientWidth
+
+template <class ItemType>
+template <class Visitor>
+void CompactPoly<ItemType>::forEachTerm(Visitor&& visit) const
+{
+    const unsigned char* position = powerStream();
+    unsigned int power = 0;
+    for (size_t i = 0; i < termCount; i++)
+    {
+        power = (i == 0) ? readVarint(position) : power - readVarint(position);
+        visit(coefficientAt(i), power);
+    } // End for
+}  // End forEachTerm
+
+template <class ItemType>
+std::string CompactPoly<ItemType>::displayPoly() const
+{
+    return thaw().displayPoly();
+}  // End displayPoly
+
+template <class ItemType>
+SparsePoly<ItemType> CompactPoly<ItemType>::thaw() const
+{
+    SparsePoly<ItemType> result(variable);
+    std::vector<Node<ItemType>> terms;
+    terms.reserve(termCount);
+    forEachTerm([&terms](const ItemType& coefficient, unsigned int power)
+    {
+        terms.push_back(Node<ItemType>(coefficient, power));
+    });
+    result.assignTerms(terms);
+    return result;
+}  // End thaw
+
+template <class ItemType>
+PolyFootprint CompactPoly<ItemType>::memoryFootprint() const
+{
+    return PolyFootprint(sizeof(CompactPoly), buffer.capacity(), buffer.capacity() > 0 ? 1 : 0);
+}  // End memoryFootprint
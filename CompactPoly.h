@@ -0,0 +1,191 @@
+/** @file CompactPoly.h
+* @class CompactPoly
+* Frozen, read-only form of a sparse polynomial for keeping large sets of polynomials in memory. All of the terms live
+* in one exactly sized byte buffer: the coefficients come first, each stored in the narrowest width that gives back the
+* same value, followed by a checkpoint table and the powers. Powers are delta encoded from highest to lowest as
+* variable-length integers (7 bits per byte), so dense runs take one byte per term. Every CHECKPOINT_SPACING terms the
+* table records the power and the position in the power stream, so coefficient only decodes a short run of powers.
+*
+* A CompactPoly cannot be changed; thaw it back into a SparsePoly to edit it.
+*/
+
+#ifndef COMPACT_POLY_
+#define COMPACT_POLY_
+
+#include "SparsePoly.h"
+#include "Node.h"
+#include "PolyKernels.h"
+#include "PolyInstrumentation.h"
+#include "PolyFootprint.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+template <class ItemType>
+class CompactPoly
+{
+    static_assert(std::is_arithmetic<ItemType>::value, "CompactPoly requires an arithmetic coefficient type");
+
+private:
+    /** Number of terms between two entries of the checkpoint table. */
+    static constexpr size_t CHECKPOINT_SPACING = 32;
+
+    /** Bytes in one checkpoint: the power of the term and the offset of the next gap in the power stream. */
+    static constexpr size_t CHECKPOINT_BYTES = 2 * sizeof(std::uint32_t);
+
+    /** Coefficients, then the checkpoint table, then the power stream. */
+    std::vector<unsigned char> buffer;
+
+    /** Number of terms stored. */
+    size_t termCount;
+
+    /** Bytes per stored coefficient. For floating point types 4 means float and 8 means double. */
+    unsigned char coefficientWidth;
+
+    /** Character for polynomial variable, default is 'x'. */
+    char variable;
+
+    /** Stored coefficient type for a width: the signed or unsigned integer of that width, or float and double for
+    * floating point coefficients. Widths 1 and 2 are never chosen for floating point. */
+    template <class Signed, class Unsigned, class Floating>
+    using Narrow = typename std::conditional<std::is_floating_point<ItemType>::value, Floating,
+        typename std::conditional<std::is_signed<ItemType>::value, Signed, Unsigned>::type>::type;
+    using Narrow8 = Narrow<std::int8_t, std::uint8_t, ItemType>;
+    using Narrow16 = Narrow<std::int16_t, std::uint16_t, ItemType>;
+    using Narrow32 = Narrow<std::int32_t, std::uint32_t, float>;
+    using Narrow64 = Narrow<std::int64_t, std::uint64_t, double>;
+
+    /** Picks the narrowest width every coefficient round-trips through.
+    * @param terms The terms to store.
+    * @return The width in bytes. */
+    static unsigned char chooseWidth(const std::vector<Node<ItemType>>& terms);
+
+    /** @return True if value comes back unchanged after storing it as a Stored. */
+    template <class Stored>
+    static bool roundTrips(ItemType value);
+
+    /** @return True if value comes back unchanged after storing it in width bytes. */
+    static bool fitsWidth(ItemType value, unsigned char width);
+
+    /** @return False for a floating point value outside the finite range of Stored, which cannot be converted. */
+    template <class Stored>
+    static bool inRange(ItemType value, std::true_type isFloatingPoint);
+
+    /** @return True; every integer converts, wrapping if it does not fit. */
+    template <class Stored>
+    static bool inRange(ItemType value, std::false_type isFloatingPoint);
+
+    /** Stores a coefficient in width bytes at the given address. */
+    static void writeCoefficient(unsigned char* target, ItemType value, unsigned char width);
+
+    /** Appends a value as a variable-length integer. */
+    static void writeVarint(std::vector<unsigned char>& stream, unsigned int value);
+
+    /** Decodes a variable-length integer and advances the read position past it. */
+    static unsigned int readVarint(const unsigned char*& position);
+
+    /** @return The coefficient of the term at the given index. */
+    ItemType coefficientAt(size_t index) const;
+
+    /** @return The number of entries in the checkpoint table. */
+    size_t checkpointCount() const;
+
+    /** @return The address of the checkpoint table. */
+    const unsigned char* checkpoints() const;
+
+    /** @return The address of the power stream. */
+    const unsigned char* powerStream() const;
+
+public:
+    /** Default constructor for an empty polynomial in 'x'.
+    * @pre None
+    * @post None */
+    CompactPoly();
+
+    /** Compacts a linked list polynomial.
+    * @pre None
+    * @post The compact polynomial has the same terms and variable as other.
+    * @param other The polynomial to compact. */
+    explicit CompactPoly(const SparsePoly<ItemType>& other);
+
+    /** Compacts every polynomial of a collection into a vector that holds exactly that many.
+    * @pre None
+    * @post Does not change the polynomials.
+    * @param polys The polynomials to compact.
+    * @return The compact polynomials, in the same order. */
+    static std::vector<CompactPoly> compactAll(const std::vector<SparsePoly<ItemType>>& polys);
+
+    /** Returns the coefficient in the term of a given power.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param power The power of the target term.
+    * @return The coefficient of the indicated term or 0 if there is no such term. */
+    ItemType coefficient(unsigned int power) const;
+
+    /** Evaluates the polynomial at a given value of the variable with Horner's rule, decoding the powers as it goes.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param x The value given for the variable.
+    * @return The result of evaluating the polynomial at that value. */
+    ItemType evaluate(ItemType x) const;
+
+    /** Retrieves the degree of the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return Returns the degree of the polynomial or -1 if the polynomial is empty. */
+    unsigned int degree() const;
+
+    /** Checks if polynomial contains terms.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return True if the polynomial has no terms. */
+    bool isEmpty() const;
+
+    /** Retrieves the variable character of the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The variable character. */
+    char getVariable() const;
+
+    /** Retrieves the number of terms in the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The number of nonzero terms. */
+    int getTermCount() const;
+
+    /** Retrieves the width the coefficients are stored in.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return Bytes per coefficient. */
+    size_t getCoefficientWidth() const;
+
+    /** Visits every term from the highest to the lowest power.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param visit Callable invoked as visit(coefficient, power) for each term. */
+    template <class Visitor>
+    void forEachTerm(Visitor&& visit) const;
+
+    /** Displays the polynomial in the same format as SparsePoly.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A string of the polynomial, or '0' if the polynomial is empty. */
+    std::string displayPoly() const;
+
+    /** Expands the polynomial back into an editable linked list polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A SparsePoly with the same terms and variable. */
+    SparsePoly<ItemType> thaw() const;
+
+    /** Reports the memory used by the polynomial: the object and its single buffer.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The footprint. */
+    PolyFootprint memoryFootprint() const;
+}; // end CompactPoly
+
+#include "CompactPoly.cpp"
+#endif
@@ -0,0 +1,285 @@
+/** @file CompiledPoly.cpp
+* Evaluators specialized by gap pattern and term count, with Estrin's scheme unrolled for dense coefficient blocks.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "CompiledPoly.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Default constructor
+template <class ItemType>
+CompiledPoly<ItemType>::CompiledPoly()
+    : length(0), offset(0), stride(1), polyDegree(static_cast<unsigned int>(-1)), termCount(0), shape(CompiledShape::Dense),
+    kernel(&CompiledPoly<ItemType>::zeroKernel), variable('x')
+{ }  // End default constructor
+
+// Returns the first block of the coefficient table
+template <class ItemType>
+const ItemType* CompiledPoly<ItemType>::coefficients() const
+{
+    return table.front().coefficients;
+}  // End coefficients
+
+// Returns one coefficient slot of the table
+template <class ItemType>
+ItemType& CompiledPoly<ItemType>::slot(size_t index)
+{
+    return table[index / BLOCK_LENGTH].coefficients[index % BLOCK_LENGTH];
+}  // End slot
+
+// Kernel for the empty polynomial
+template <class ItemType>
+ItemType CompiledPoly<ItemType>::zeroKernel(const CompiledPoly&, ItemType)
+{
+    return static_cast<ItemType>(0);
+}  // End zeroKernel
+
+// Evaluates q with N coefficients in one Estrin block
+template <class ItemType>
+template <size_t N, bool Strided>
+ItemType CompiledPoly<ItemType>::blockKernel(const CompiledPoly& poly, ItemType x)
+{
+    ItemType squares[PolyEstrin<ItemType, N>::SQUARES + 1];
+    squares[0] = Strided ? PolyKernels<ItemType>::power(x, poly.stride) : x;
+    for (size_t i = 1; i < PolyEstrin<ItemType, N>::SQUARES; i++)
+    {
+        squares[i] = squares[i - 1] * squares[i - 1];
+    } // End for
+    const ItemType value = PolyEstrin<ItemType, N>::run(poly.coefficients(), squares);
+    return Strided ? value * PolyKernels<ItemType>::power(x, poly.offset) : value;
+}  // End blockKernel
+
+// Evaluates q block by block, combining the blocks by Horner's rule in x^BLOCK_LENGTH
+template <class ItemType>
+template <bool Strided>
+ItemType CompiledPoly<ItemType>::blockedKernel(const CompiledPoly& poly, ItemType x)
+{
+    using Block = PolyEstrin<ItemType, BLOCK_LENGTH>;
+    ItemType squares[Block::SQUARES + 1];
+    squares[0] = Strided ? PolyKernels<ItemType>::power(x, poly.stride) : x;
+    for (size_t i = 1; i <= Block::SQUARES; i++)
+    {
+        squares[i] = squares[i - 1] * squares[i - 1];
+    } // End for
+    const ItemType shift = squares[Block::SQUARES]; // x^BLOCK_LENGTH
+
+    // Each block is independent of the running sum, so its Estrin tree overlaps the previous Horner step
+    ItemType value = Block::run(poly.table.back().coefficients, squares);
+    for (size_t j = poly.table.size() - 1; j > 0; j--)
+    {
+        value = value * shift + Block::run(poly.table[j - 1].coefficients, squares);
+    } // End for
+    return Strided ? value * PolyKernels<ItemType>::power(x, poly.offset) : value;
+}  // End blockedKernel
+
+// Evaluates sparse terms by Horner's rule over the gaps
+template <class ItemType>
+template <size_t N>
+ItemType CompiledPoly<ItemType>::sparseKernel(const CompiledPoly& poly, ItemType x)
+{
+    // A constant trip count lets the compiler unroll; N = 0 walks every block of the table
+    const size_t count = (N == 0) ? poly.length : N;
+    const ItemType* coefficients = poly.coefficients();
+    ItemType value = coefficients[0];
+    for (size_t i = 1; i < count; i++)
+    {
+        const ItemType coefficient = (N == 0) ? poly.table[i / BLOCK_LENGTH].coefficients[i % BLOCK_LENGTH] : coefficients[i];
+        value = value * PolyKernels<ItemType>::power(x, poly.gaps[i - 1]) + coefficient;
+    } // End for
+    return value * PolyKernels<ItemType>::power(x, poly.offset);
+}  // End sparseKernel
+
+// Picks the block kernel instantiated for a length
+template <class ItemType>
+template <bool Strided, size_t... N>
+typename CompiledPoly<ItemType>::Kernel CompiledPoly<ItemType>::pickBlockKernel(size_t count, std::index_sequence<N...>)
+{
+    static const Kernel kernels[] = { &CompiledPoly<ItemType>::template blockKernel<N + 1, Strided>... };
+    return (count <= BLOCK_LENGTH) ? kernels[count - 1] : &CompiledPoly<ItemType>::template blockedKernel<Strided>;
+}  // End pickBlockKernel
+
+// Picks the sparse kernel instantiated for a term count
+template <class ItemType>
+template <size_t... N>
+typename CompiledPoly<ItemType>::Kernel CompiledPoly<ItemType>::pickSparseKernel(size_t count, std::index_sequence<N...>)
+{
+    static const Kernel kernels[] = { &CompiledPoly<ItemType>::template sparseKernel<N + 1>... };
+    return (count <= BLOCK_LENGTH) ? kernels[count - 1] : &CompiledPoly<ItemType>::template sparseKernel<0>;
+}  // End pickSparseKernel
+
+// Lays out the coefficients and picks the kernel for a shape
+template <class ItemType>
+void CompiledPoly<ItemType>::build(const std::vector<Node<ItemType>>& terms, CompiledShape someShape, unsigned int divisor)
+{
+    shape = someShape;
+    offset = terms.back().getPower();
+    gaps.clear();
+    if (shape == CompiledShape::Sparse)
+    {
+        stride = 0;
+        length = terms.size();
+        table.assign((length + BLOCK_LENGTH - 1) / BLOCK_LENGTH, CoefficientBlock());
+        for (size_t i = 0; i < terms.size(); i++)
+        {
+            slot(i) = terms[i].getCoefficient();
+            if (i > 0)
+            {
+                gaps.push_back(terms[i - 1].getPower() - terms[i].getPower());
+            } // End if
+        } // End for
+        kernel = pickSparseKernel(length, std::make_index_sequence<BLOCK_LENGTH>());
+        return;
+    } // End if
+
+    stride = divisor;
+    length = (terms.front().getPower() - offset) / stride + 1;
+    table.assign((length + BLOCK_LENGTH - 1) / BLOCK_LENGTH, CoefficientBlock()); // Value initialized blocks are all zeros
+    for (const Node<ItemType>& term : terms)
+    {
+        slot((term.getPower() - offset) / stride) = term.getCoefficient();
+    } // End for
+    kernel = (shape == CompiledShape::Dense)
+        ? pickBlockKernel<false>(length, std::make_index_sequence<BLOCK_LENGTH>())
+        : pickBlockKernel<true>(length, std::make_index_sequence<BLOCK_LENGTH>());
+}  // End build
+
+// Returns the default sample points of the check
+template <class ItemType>
+std::vector<ItemType> CompiledPoly<ItemType>::samplePoints()
+{
+    const size_t CHEBYSHEV_POINTS = 16;
+    std::vector<ItemType> points = { 0, 1, -1, 2, -2 };
+    const double pi = std::acos(-1.0);
+    for (size_t i = 0; i < CHEBYSHEV_POINTS; i++)
+    {
+        points.push_back(static_cast<ItemType>(std::cos(pi * (2.0 * i + 1.0) / (2.0 * CHEBYSHEV_POINTS))));
+    } // End for
+    return points;
+}  // End samplePoints
+
+// Compiles a polynomial and checks it against the reference
+template <class ItemType>
+CompiledPoly<ItemType> CompiledPoly<ItemType>::compile(const SparsePoly<ItemType>& poly)
+{
+    CompiledPoly<ItemType> result;
+    result.variable = poly.getVariable();
+    if (poly.isEmpty())
+    {
+        return result;
+    } // End if
+    std::vector<Node<ItemType>> terms;
+    terms.reserve(static_cast<size_t>(poly.getTermCount()));
+    poly.forEachTerm([&terms](const ItemType& coefficient, unsigned int power)
+    {
+        terms.push_back(Node<ItemType>(coefficient, power));
+    });
+    result.polyDegree = terms.front().getPower();
+    result.termCount = poly.getTermCount();
+
+    // The stride is the gcd of every power's distance from the lowest power; a single term has stride 1
+    const unsigned int lowest = terms.back().getPower();
+    unsigned int divisor = 0;
+    for (const Node<ItemType>& term : terms)
+    {
+        unsigned int a = term.getPower() - lowest;
+        unsigned int b = divisor;
+        while (b != 0)
+        {
+            const unsigned int r = a % b;
+            a = b;
+            b = r;
+        } // End while
+        divisor = a;
+    } // End for
+    divisor = std::max(divisor, 1u);
+
+    const size_t slots = (result.polyDegree - lowest) / divisor + 1;
+    CompiledShape shape = CompiledShape::Sparse;
+    if (slots <= DENSE_SLOTS_PER_TERM * terms.size())
+    {
+        shape = (divisor == 1 && lowest == 0) ? CompiledShape::Dense : CompiledShape::Strided;
+    } // End if
+    result.build(terms, shape, divisor);
+
+    // Estrin's scheme adds in a different order from the reference; keep it only within the rounding bound
+    const ItemType accepted = static_cast<ItemType>(4 * (static_cast<size_t>(result.polyDegree) + 2));
+    if (shape != CompiledShape::Sparse && result.validate(poly, samplePoints()) > accepted)
+    {
+        result.build(terms, CompiledShape::Sparse, divisor);
+    } // End if
+    return result;
+}  // End compile
+
+// Evaluates through the selected kernel
+template <class ItemType>
+ItemType CompiledPoly<ItemType>::evaluate(ItemType x) const
+{
+    return kernel(*this, x);
+}  // End evaluate
+
+// Measures the error against the reference in units of the rounding bound
+template <class ItemType>
+ItemType CompiledPoly<ItemType>::validate(const SparsePoly<ItemType>& poly, const std::vector<ItemType>& points) const
+{
+    ItemType worst = 0;
+    for (ItemType x : points)
+    {
+        const ItemType expected = poly.evaluate(x);
+        if (!std::isfinite(expected))
+        {
+            continue;
+        } // End if
+        ItemType magnitude = 0; // sum |c_k| |x|^k
+        poly.forEachTerm([&magnitude, x](const ItemType& coefficient, unsigned int power)
+        {
+            magnitude += std::fabs(coefficient) * std::pow(std::fabs(x), static_cast<ItemType>(power));
+        });
+        const ItemType error = std::fabs(evaluate(x) - expected);
+        if (error == 0)
+        {
+            continue;
+        } // End if
+        const ItemType bound = std::numeric_limits<ItemType>::epsilon() * magnitude;
+        worst = std::max(worst, (bound > 0) ? error / bound : std::numeric_limits<ItemType>::infinity());
+    } // End for
+    return worst;
+}  // End validate
+
+// Returns the gap pattern
+template <class ItemType>
+CompiledShape CompiledPoly<ItemType>::getShape() const
+{
+    return shape;
+}  // End getShape
+
+// Returns the stride
+template <class ItemType>
+unsigned int CompiledPoly<ItemType>::getStride() const
+{
+    return stride;
+}  // End getStride
+
+// Returns the degree
+template <class ItemType>
+unsigned int CompiledPoly<ItemType>::degree() const
+{
+    return polyDegree;
+}  // End degree
+
+// Returns the number of terms
+template <class ItemType>
+int CompiledPoly<ItemType>::getTermCount() const
+{
+    return termCount;
+}  // End getTermCount
+
+// Returns the variable character
+template <class ItemType>
+char CompiledPoly<ItemType>::getVariable() const
+{
+    return variable;
+}  // End getVariable
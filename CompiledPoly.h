@@ -0,0 +1,210 @@
+/** @file CompiledPoly.h
+* @class CompiledPoly
+* Read-only evaluator specialized to one polynomial, for polynomials that stay fixed while being evaluated many times.
+* Compiling a SparsePoly classifies the gaps between its powers and picks one of a set of kernels instantiated ahead of
+* time for each term count up to BLOCK_LENGTH:
+*  - Dense: every power up to the degree, or enough of them that filling in zeros is cheaper than skipping them. The
+*    coefficients are evaluated with Estrin's scheme, unrolled at compile time, whose independent halves keep several
+*    multiplications in flight instead of the single dependency chain of Horner's rule.
+*  - Strided: powers offset + k * stride, such as even or odd polynomials, evaluated as x^offset q(x^stride) with the
+*    dense kernel for q.
+*  - Sparse: anything else, evaluated by Horner's rule over the gaps.
+* Longer dense polynomials are cut into blocks of BLOCK_LENGTH coefficients, each block evaluated with Estrin's scheme and
+* the blocks combined by Horner's rule in x^BLOCK_LENGTH. Coefficients live in one table of cache line aligned blocks.
+*
+* Compiling checks the kernel against SparsePoly::evaluate at sample points and falls back to the sparse kernel if the
+* error exceeds the rounding bound.
+*/
+
+#ifndef COMPILED_POLY_
+#define COMPILED_POLY_
+
+#include "SparsePoly.h"
+#include "Node.h"
+#include "PolyKernels.h"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/** Estrin's scheme for N coefficients, unrolled at compile time: the low part holds the largest power of two below N
+* coefficients and the high part is shifted past it by one of the repeated squares of x. */
+template <class ItemType, size_t N>
+struct PolyEstrin
+{
+    /** @return The largest power of two below n, starting the search at p. */
+    static constexpr size_t lowLength(size_t n, size_t p = 1)
+    {
+        return (2 * p < n) ? lowLength(n, 2 * p) : p;
+    }
+
+    /** @return The base 2 logarithm of a power of two. */
+    static constexpr size_t level(size_t p)
+    {
+        return (p <= 1) ? 0 : 1 + level(p / 2);
+    }
+
+    static constexpr size_t LOW = lowLength(N);
+
+    /** Number of repeated squares x, x^2, x^4, ... the scheme reads. */
+    static constexpr size_t SQUARES = level(LOW) + 1;
+
+    /** @param coefficients N coefficients, lowest power first.
+    * @param squares squares[i] holds x^(2^i).
+    * @return The value of the polynomial. */
+    static ItemType run(const ItemType* coefficients, const ItemType* squares)
+    {
+        return PolyEstrin<ItemType, LOW>::run(coefficients, squares)
+            + squares[level(LOW)] * PolyEstrin<ItemType, N - LOW>::run(coefficients + LOW, squares);
+    }
+}; // end PolyEstrin
+
+template <class ItemType>
+struct PolyEstrin<ItemType, 1>
+{
+    static constexpr size_t SQUARES = 0;
+
+    static ItemType run(const ItemType* coefficients, const ItemType*)
+    {
+        return coefficients[0];
+    }
+}; // end PolyEstrin
+
+/** Gap patterns a CompiledPoly recognizes. */
+enum class CompiledShape
+{
+    Dense,
+    Strided,
+    Sparse
+};
+
+template <class ItemType>
+class CompiledPoly
+{
+    static_assert(std::is_floating_point<ItemType>::value, "CompiledPoly requires a floating point coefficient type");
+
+private:
+    /** Coefficients evaluated by one unrolled Estrin kernel; also the largest term count with its own kernel. */
+    static constexpr size_t BLOCK_LENGTH = 16;
+
+    /** A gap pattern is stored dense while it has at most this many slots per term. */
+    static constexpr size_t DENSE_SLOTS_PER_TERM = 4;
+
+    /** One cache line aligned block of the coefficient table. */
+    struct alignas(64) CoefficientBlock
+    {
+        ItemType coefficients[BLOCK_LENGTH];
+    };
+
+    using Kernel = ItemType (*)(const CompiledPoly& poly, ItemType x);
+
+    /** Dense and strided shapes: coefficients of q lowest power first, padded with zeros to whole blocks. Sparse shape:
+    * coefficients from the highest power down. */
+    std::vector<CoefficientBlock> table;
+
+    /** Sparse shape only: gaps[i] is the power of term i minus the power of term i + 1, from the highest power down. */
+    std::vector<unsigned int> gaps;
+
+    /** Number of coefficients in use: the length of q, or the number of terms for the sparse shape. */
+    size_t length;
+
+    /** The polynomial is x^offset q(x^stride); offset is also the lowest power of the sparse shape. */
+    unsigned int offset;
+    unsigned int stride;
+
+    /** Degree of the compiled polynomial, or -1 when it is empty. */
+    unsigned int polyDegree;
+
+    /** Number of nonzero terms of the compiled polynomial. */
+    int termCount;
+
+    CompiledShape shape;
+    Kernel kernel;
+
+    /** Character for polynomial variable, default is 'x'. */
+    char variable;
+
+    /** @return The first block of the coefficient table, which holds every coefficient of the single block kernels. */
+    const ItemType* coefficients() const;
+
+    /** @return Slot index of the coefficient table, counted across blocks. */
+    ItemType& slot(size_t index);
+
+    /** Kernel for the empty polynomial. */
+    static ItemType zeroKernel(const CompiledPoly& poly, ItemType x);
+
+    /** Kernel for q with N coefficients, N at most BLOCK_LENGTH, in one Estrin block. Strided kernels evaluate q at
+    * x^stride and multiply by x^offset. */
+    template <size_t N, bool Strided>
+    static ItemType blockKernel(const CompiledPoly& poly, ItemType x);
+
+    /** Kernel for q longer than one block: Estrin's scheme inside each block and Horner's rule in x^BLOCK_LENGTH across them. */
+    template <bool Strided>
+    static ItemType blockedKernel(const CompiledPoly& poly, ItemType x);
+
+    /** Kernel for N sparse terms by Horner's rule over the gaps; N = 0 reads the term count at run time. */
+    template <size_t N>
+    static ItemType sparseKernel(const CompiledPoly& poly, ItemType x);
+
+    /** Helpers that pick the kernel instantiated for a length, from tables built over 1 ... BLOCK_LENGTH. */
+    template <bool Strided, size_t... N>
+    static Kernel pickBlockKernel(size_t count, std::index_sequence<N...>);
+    template <size_t... N>
+    static Kernel pickSparseKernel(size_t count, std::index_sequence<N...>);
+
+    /** Helper that lays out the coefficients and picks the kernel for a shape.
+    * @param terms The terms, from the highest power down.
+    * @param someShape The shape to build.
+    * @param divisor For the dense and strided shapes, the gcd of the power differences from the lowest power. */
+    void build(const std::vector<Node<ItemType>>& terms, CompiledShape someShape, unsigned int divisor);
+
+    /** @return The default sample points of the check made by compile: 0, +-1, +-2 and Chebyshev points in [-1, 1]. */
+    static std::vector<ItemType> samplePoints();
+
+public:
+    /** Default constructor for the empty polynomial.
+    * @pre None
+    * @post None */
+    CompiledPoly();
+
+    /** Compiles a polynomial: picks the shape and kernel and checks it against SparsePoly::evaluate at samplePoints.
+    * @pre None
+    * @post None
+    * @param poly The polynomial to compile.
+    * @return The evaluator; its shape is Sparse if the check sent it back to Horner's rule. */
+    static CompiledPoly compile(const SparsePoly<ItemType>& poly);
+
+    /** Evaluates the compiled polynomial.
+    * @pre None
+    * @post Does not change the evaluator.
+    * @param x The value given for the variable.
+    * @return The value of the polynomial at x. */
+    ItemType evaluate(ItemType x) const;
+
+    /** Measures the error of the evaluator against SparsePoly::evaluate, in units of the rounding bound
+    * epsilon * sum |c_k| |x|^k. Points where the reference is not finite are skipped.
+    * @pre poly is the polynomial that was compiled.
+    * @post Does not change the evaluator.
+    * @param poly The reference polynomial.
+    * @param points The values to check at.
+    * @return The largest error over the points; compile accepts up to 4 (degree + 2). */
+    ItemType validate(const SparsePoly<ItemType>& poly, const std::vector<ItemType>& points) const;
+
+    /** @return The gap pattern the evaluator was built for. */
+    CompiledShape getShape() const;
+
+    /** @return The stride of the dense or strided shape, 0 for the sparse shape. */
+    unsigned int getStride() const;
+
+    /** @return The degree, or -1 if the polynomial is empty. */
+    unsigned int degree() const;
+
+    /** @return The number of nonzero terms. */
+    int getTermCount() const;
+
+    /** @return The variable character. */
+    char getVariable() const;
+}; // end CompiledPoly
+
+#include "CompiledPoly.cpp"
+#endif
@@ -0,0 +1,484 @@
+/** @file PolyDifferential.cpp
+* Differential test harness that checks every sparse polynomial backend against a dense reference model. This file is
+* included by its header, so the non-template functions are inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyDifferential.h"
+#include <algorithm>
+#include <cstdlib>
+#include <random>
+#include <utility>
+
+struct PolyDifferential::Operands
+{
+    SparsePoly<long long> sparse[2];
+    SmallSparsePoly<long long, 4> small[2]; // Few inline terms, so runs cross between inline and heap storage
+    SharedSparsePoly<long long> shared[2];
+    Reference reference[2];
+};
+
+inline PolyDifferential::Reference::Reference() : variable('x')
+{ }  // End Reference constructor
+
+inline void PolyDifferential::Reference::trim()
+{
+    while (!coefficients.empty() && coefficients.back() == 0)
+    {
+        coefficients.pop_back();
+    } // End while
+}  // End trim
+
+inline unsigned int PolyDifferential::Reference::termCount() const
+{
+    unsigned int count = 0;
+    for (long long coefficient : coefficients)
+    {
+        count += (coefficient != 0) ? 1 : 0;
+    } // End for
+    return count;
+}  // End termCount
+
+inline long long PolyDifferential::Reference::largest() const
+{
+    long long result = 0;
+    for (long long coefficient : coefficients)
+    {
+        long long magnitude = (coefficient < 0) ? -coefficient : coefficient;
+        result = (magnitude > result) ? magnitude : result;
+    } // End for
+    return result;
+}  // End largest
+
+// Byte 0 picks the kind, the operand and whether the value is kept small; byte 1 is the value; bytes 2 and 3 the power
+inline std::vector<PolyDifferential::Op> PolyDifferential::decode(const std::uint8_t* data, size_t size)
+{
+    std::vector<Op> ops;
+    ops.reserve(size / OP_BYTES);
+    for (size_t i = 0; i + OP_BYTES <= size; i += OP_BYTES)
+    {
+        Op op;
+        op.kind = static_cast<OpKind>(data[i] % static_cast<unsigned int>(OpKind::Count));
+        op.target = static_cast<unsigned char>((data[i] >> 3) & 1);
+        op.value = static_cast<signed char>(data[i + 1]);
+        if ((data[i] >> 4) & 1)
+        {
+            // Small values make cancellation to 0 likely
+            op.value %= 4;
+        } // End if
+        op.power = (static_cast<unsigned int>(data[i + 2]) | (static_cast<unsigned int>(data[i + 3]) << 8)) % (MAX_POWER + 1);
+        ops.push_back(op);
+    } // End for
+    return ops;
+}  // End decode
+
+inline std::vector<PolyDifferential::Op> PolyDifferential::randomOps(std::uint64_t seed, size_t count)
+{
+    std::mt19937_64 generator(seed);
+    std::vector<std::uint8_t> bytes(count * OP_BYTES);
+    for (std::uint8_t& byte : bytes)
+    {
+        byte = static_cast<std::uint8_t>(generator());
+    } // End for
+    return decode(bytes.data(), bytes.size());
+}  // End randomOps
+
+template <class Poly>
+std::string PolyDifferential::compare(const Poly& poly, const Reference& reference, const std::string& expected, const std::string& name)
+{
+    std::string problem;
+    if (poly.getVariable() != reference.variable)
+    {
+        problem = std::string("variable is ") + poly.getVariable() + " but should be " + reference.variable;
+    }
+    else if (poly.getTermCount() != static_cast<int>(reference.termCount()))
+    {
+        problem = "term count is " + std::to_string(poly.getTermCount()) + " but should be " + std::to_string(reference.termCount());
+    }
+    else if (!reference.coefficients.empty() && poly.degree() != reference.coefficients.size() - 1)
+    {
+        problem = "degree is " + std::to_string(poly.degree()) + " but should be " + std::to_string(reference.coefficients.size() - 1);
+    }
+    else if (poly.displayPoly() != expected)
+    {
+        problem = "displays as " + poly.displayPoly();
+    } // End if
+
+    // Terms must arrive from the highest to the lowest power with nonzero coefficients matching the reference
+    if (problem.empty())
+    {
+        size_t next = reference.coefficients.size();
+        poly.forEachTerm([&](const long long& coefficient, unsigned int power)
+        {
+            while (next > 0 && reference.coefficients[next - 1] == 0)
+            {
+                next--;
+            } // End while
+            if (problem.empty() && (next == 0 || power != next - 1 || coefficient != reference.coefficients[next - 1]))
+            {
+                problem = "forEachTerm visits " + std::to_string(coefficient) + " at power " + std::to_string(power);
+            } // End if
+            next = (next > 0) ? next - 1 : 0;
+        });
+    } // End if
+
+    // Spot check coefficient at a spread of powers, including missing ones just past the degree
+    if (problem.empty())
+    {
+        const unsigned int limit = static_cast<unsigned int>(reference.coefficients.size()) + 2;
+        const unsigned int stride = limit / 16 + 1;
+        for (unsigned int power = 0; power < limit && problem.empty(); power += stride)
+        {
+            long long expectedCoefficient = (power < reference.coefficients.size()) ? reference.coefficients[power] : 0;
+            if (poly.coefficient(power) != expectedCoefficient)
+            {
+                problem = "coefficient(" + std::to_string(power) + ") is " + std::to_string(poly.coefficient(power)) + " but should be " + std::to_string(expectedCoefficient);
+            } // End if
+        } // End for
+    } // End if
+
+    if (problem.empty())
+    {
+        return problem;
+    } // End if
+    return name + " " + problem + " (reference is " + expected + ")";
+}  // End compare
+
+inline std::string PolyDifferential::verify(const Operands& operands, unsigned int index)
+{
+    const Reference& reference = operands.reference[index];
+    SparsePoly<long long> expectedPoly(reference.variable);
+    std::vector<Node<long long>> terms;
+    for (size_t power = reference.coefficients.size(); power > 0; power--)
+    {
+        if (reference.coefficients[power - 1] != 0)
+        {
+            terms.push_back(Node<long long>(reference.coefficients[power - 1], static_cast<unsigned int>(power - 1)));
+        } // End if
+    } // End for
+    expectedPoly.assignTerms(terms);
+    const std::string expected = expectedPoly.displayPoly();
+    const std::string operand = " p" + std::to_string(index);
+
+    std::string failure = compare(operands.sparse[index], reference, expected, "SparsePoly" + operand);
+    if (failure.empty() && (operands.sparse[index] != expectedPoly || operands.sparse[index].hash() != expectedPoly.hash()))
+    {
+        // The incremental hash of the edited polynomial must match the hash of the same terms built in one pass
+        failure = "SparsePoly" + operand + " equality or hash differs from the same terms built from the reference";
+    } // End if
+    if (failure.empty())
+    {
+        failure = compare(operands.small[index], reference, expected, "SmallSparsePoly" + operand);
+    } // End if
+    if (failure.empty())
+    {
+        failure = compare(operands.shared[index], reference, expected, "SharedSparsePoly" + operand);
+    } // End if
+    if (failure.empty())
+    {
+        failure = compare(CompactPoly<long long>(operands.sparse[index]), reference, expected, "CompactPoly" + operand);
+    } // End if
+    return failure;
+}  // End verify
+
+inline std::string PolyDifferential::step(Operands& operands, const Op& op, std::string& statement)
+{
+    const unsigned int t = op.target;
+    const unsigned int o = 1 - t;
+    const std::string self = "p" + std::to_string(t);
+    Reference& reference = operands.reference[t];
+
+    switch (op.kind)
+    {
+    case OpKind::ChangeCoefficient:
+    case OpKind::RemoveTerm:
+    {
+        unsigned int power = op.power;
+        long long coefficient = (op.kind == OpKind::ChangeCoefficient) ? op.value : 0;
+        if (op.kind == OpKind::RemoveTerm && reference.termCount() > 0)
+        {
+            // Pick an existing term so removals mostly hit
+            unsigned int skip = op.power % reference.termCount();
+            for (power = 0; reference.coefficients[power] == 0 || skip-- > 0; power++)
+            { }
+        } // End if
+        statement = self + ".changeCoefficient(" + std::to_string(coefficient) + ", " + std::to_string(power) + ");";
+        if (power >= reference.coefficients.size())
+        {
+            reference.coefficients.resize(power + 1, 0);
+        } // End if
+        reference.coefficients[power] = coefficient;
+        reference.trim();
+        operands.sparse[t].changeCoefficient(coefficient, power);
+        operands.small[t].changeCoefficient(coefficient, power);
+        operands.shared[t].changeCoefficient(coefficient, power);
+        break;
+    }
+    case OpKind::Clear:
+    {
+        statement = self + ".clear();";
+        reference.coefficients.clear();
+        operands.sparse[t].clear();
+        operands.small[t].clear();
+        operands.shared[t].clear();
+        break;
+    }
+    case OpKind::Reset:
+    {
+        const char variable = (op.value & 1) ? 'y' : 'x';
+        statement = self + " = SparsePoly<long long>('" + variable + "');";
+        reference = Reference();
+        reference.variable = variable;
+        operands.sparse[t] = SparsePoly<long long>(variable);
+        operands.small[t] = SmallSparsePoly<long long, 4>(variable);
+        operands.shared[t].assign(SparsePoly<long long>(variable));
+        break;
+    }
+    case OpKind::Add:
+    case OpKind::Multiply:
+    {
+        // An odd value combines the operand with itself
+        const unsigned int b = (op.value & 1) ? t : o;
+        const bool adding = op.kind == OpKind::Add;
+        statement = self + " = " + self + (adding ? ".add(p" : ".multiply(p") + std::to_string(b) + ");";
+        const Reference& other = operands.reference[b];
+        Reference result;
+        if (reference.variable == other.variable)
+        {
+            result.variable = reference.variable;
+            if (adding)
+            {
+                result.coefficients = reference.coefficients;
+                result.coefficients.resize(std::max(reference.coefficients.size(), other.coefficients.size()), 0);
+                for (size_t i = 0; i < other.coefficients.size(); i++)
+                {
+                    result.coefficients[i] += other.coefficients[i];
+                } // End for
+            }
+            else if (!reference.coefficients.empty() && !other.coefficients.empty())
+            {
+                if (reference.coefficients.size() + other.coefficients.size() - 2 > MAX_DEGREE
+                    || reference.largest() * other.largest() > COEFFICIENT_LIMIT * COEFFICIENT_LIMIT / (MAX_DEGREE + 1))
+                {
+                    statement = "// skipped: " + statement;
+                    return "";
+                } // End if
+                result.coefficients.assign(reference.coefficients.size() + other.coefficients.size() - 1, 0);
+                for (size_t i = 0; i < reference.coefficients.size(); i++)
+                {
+                    for (size_t j = 0; j < other.coefficients.size(); j++)
+                    {
+                        result.coefficients[i + j] += reference.coefficients[i] * other.coefficients[j];
+                    } // End for
+                } // End for
+            } // End if
+            result.trim();
+        } // End if
+        if (result.largest() > COEFFICIENT_LIMIT)
+        {
+            statement = "// skipped: " + statement;
+            return "";
+        } // End if
+
+        if (adding)
+        {
+            operands.sparse[t] = operands.sparse[t].add(operands.sparse[b]);
+            operands.small[t] = operands.small[t].add(operands.small[b]);
+        }
+        else
+        {
+            operands.sparse[t] = operands.sparse[t].multiply(operands.sparse[b]);
+            operands.small[t] = operands.small[t].multiply(operands.small[b]);
+        } // End if
+
+        // The shared backend has no arithmetic: an addition is published as one batch of changes, a product wholesale
+        SharedSparsePoly<long long>& shared = operands.shared[t];
+        if (reference.variable != other.variable)
+        {
+            shared.assign(SparsePoly<long long>());
+        }
+        else if (adding)
+        {
+            std::vector<Node<long long>> changes;
+            operands.shared[b].forEachTerm([&](const long long& coefficient, unsigned int power)
+            {
+                changes.push_back(Node<long long>(shared.coefficient(power) + coefficient, power));
+            });
+            shared.changeCoefficients(changes);
+        }
+        else
+        {
+            shared.assign(shared.toSparsePoly().multiply(operands.shared[b].toSparsePoly()));
+        } // End if
+        reference = result;
+        break;
+    }
+    case OpKind::ScalarMultiply:
+    {
+        const long long scalar = op.value % 4;
+        statement = self + " = " + self + ".scalarMultiply(" + std::to_string(scalar) + ");";
+        if (reference.largest() * (scalar < 0 ? -scalar : scalar) > COEFFICIENT_LIMIT)
+        {
+            statement = "// skipped: " + statement;
+            return "";
+        } // End if
+        for (long long& coefficient : reference.coefficients)
+        {
+            coefficient *= scalar;
+        } // End for
+        reference.trim();
+        operands.sparse[t] = operands.sparse[t].scalarMultiply(scalar);
+        operands.small[t] = operands.small[t].scalarMultiply(scalar);
+        std::vector<Node<long long>> changes;
+        operands.shared[t].forEachTerm([&](const long long& coefficient, unsigned int power)
+        {
+            changes.push_back(Node<long long>(coefficient * scalar, power));
+        });
+        operands.shared[t].changeCoefficients(changes);
+        break;
+    }
+    case OpKind::Evaluate:
+    {
+        // |x| = 2 only while the value stays exact in a double, which SparsePoly::evaluate goes through
+        long long x = op.value % 3;
+        if ((x == 2 || x == -2) && reference.coefficients.size() > 21)
+        {
+            x /= 2;
+        } // End if
+        long long expected = 0;
+        for (size_t power = reference.coefficients.size(); power > 0; power--)
+        {
+            expected = expected * x + reference.coefficients[power - 1];
+        } // End for
+        statement = self + ".evaluate(" + std::to_string(x) + "); // " + std::to_string(expected);
+        const long long values[] = { operands.sparse[t].evaluate(x), operands.small[t].evaluate(x),
+            operands.shared[t].evaluate(x), CompactPoly<long long>(operands.sparse[t]).evaluate(x) };
+        const char* names[] = { "SparsePoly", "SmallSparsePoly", "SharedSparsePoly", "CompactPoly" };
+        for (size_t i = 0; i < 4; i++)
+        {
+            if (values[i] != expected)
+            {
+                return std::string(names[i]) + " " + self + ".evaluate(" + std::to_string(x) + ") is " + std::to_string(values[i]) + " but should be " + std::to_string(expected);
+            } // End if
+        } // End for
+        return "";
+    }
+    default:
+        break;
+    } // End switch
+    return verify(operands, t);
+}  // End step
+
+inline std::string PolyDifferential::run(const std::vector<Op>& ops, std::string* transcript)
+{
+    Operands operands;
+    for (size_t i = 0; i < ops.size(); i++)
+    {
+        std::string statement;
+        std::string failure = step(operands, ops[i], statement);
+        if (transcript != nullptr)
+        {
+            *transcript += statement + "\n";
+        } // End if
+        if (!failure.empty())
+        {
+            return "step " + std::to_string(i + 1) + " (" + statement + "): " + failure;
+        } // End if
+    } // End for
+    return "";
+}  // End run
+
+inline std::vector<PolyDifferential::Op> PolyDifferential::shrink(std::vector<Op> ops)
+{
+    // Drop runs of operations, halving the run length until single operations are tried
+    for (size_t chunk = (ops.size() > 1) ? ops.size() / 2 : 1; chunk > 0; chunk /= 2)
+    {
+        size_t start = 0;
+        while (start < ops.size())
+        {
+            std::vector<Op> candidate(ops.begin(), ops.begin() + start);
+            candidate.insert(candidate.end(), ops.begin() + std::min(start + chunk, ops.size()), ops.end());
+            if (!run(candidate).empty())
+            {
+                ops = std::move(candidate);
+            }
+            else
+            {
+                start += chunk;
+            } // End if
+        } // End while
+    } // End for
+
+    // Simplify values and powers toward 0 while the sequence still fails
+    bool changed = true;
+    while (changed)
+    {
+        changed = false;
+        for (Op& op : ops)
+        {
+            // Only strictly smaller magnitudes are tried, so the loop ends
+            const int values[] = { 0, 1, -1, op.value / 2 };
+            for (int value : values)
+            {
+                if (std::abs(value) >= std::abs(op.value))
+                {
+                    continue;
+                } // End if
+                const int original = op.value;
+                op.value = value;
+                if (run(ops).empty())
+                {
+                    op.value = original;
+                }
+                else
+                {
+                    changed = true;
+                    break;
+                } // End if
+            } // End for
+            const unsigned int powers[] = { 0, 1, op.power / 2 };
+            for (unsigned int power : powers)
+            {
+                if (power >= op.power)
+                {
+                    continue;
+                } // End if
+                const unsigned int original = op.power;
+                op.power = power;
+                if (run(ops).empty())
+                {
+                    op.power = original;
+                }
+                else
+                {
+                    changed = true;
+                    break;
+                } // End if
+            } // End for
+        } // End for
+    } // End while
+    return ops;
+}  // End shrink
+
+inline std::string PolyDifferential::describe(const std::vector<Op>& ops)
+{
+    std::string transcript;
+    run(ops, &transcript);
+    return transcript;
+}  // End describe
+
+inline std::string PolyDifferential::check(std::uint64_t seed, size_t runs, size_t length)
+{
+    for (size_t i = 0; i < runs; i++)
+    {
+        std::vector<Op> ops = randomOps(seed + i, length);
+        if (!run(ops).empty())
+        {
+            std::vector<Op> minimal = shrink(ops);
+            return "seed " + std::to_string(seed + i) + ", " + run(minimal) + "\nRepro:\n" + describe(minimal);
+        } // End if
+    } // End for
+    return "";
+}  // End check
@@ -0,0 +1,150 @@
+/** @file PolyDifferential.h
+* @class PolyDifferential
+* Differential test harness for the sparse polynomial backends. A run applies one sequence of operations to two operand
+* polynomials held in every backend (SparsePoly, SmallSparsePoly, SharedSparsePoly) and in a dense reference model,
+* and after every step checks that each backend, and a CompactPoly made from the list version, holds exactly the
+* reference's terms and variable. Operations cover changeCoefficient, term removal, clear, add, multiply,
+* scalarMultiply and evaluate, including empty operands, mismatched variables, self addition and cancellation to 0.
+*
+* Operation sequences are decoded from raw bytes, so the same format drives the random property check and the libFuzzer
+* entry point in PolyFuzz.cpp. A failing sequence is shrunk to a minimal one before it is reported.
+*/
+
+#ifndef POLY_DIFFERENTIAL_
+#define POLY_DIFFERENTIAL_
+
+#include "SparsePoly.h"
+#include "SmallSparsePoly.h"
+#include "SharedSparsePoly.h"
+#include "CompactPoly.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class PolyDifferential
+{
+public:
+    /** Kinds of operation a run can apply. */
+    enum class OpKind : unsigned char
+    {
+        ChangeCoefficient,
+        RemoveTerm,
+        Clear,
+        Reset,
+        Add,
+        Multiply,
+        ScalarMultiply,
+        Evaluate,
+        Count
+    };
+
+    /** One step of a run, applied to operand target with the other operand as the second argument. */
+    struct Op
+    {
+        OpKind kind;
+        unsigned char target;
+        int value;
+        unsigned int power;
+    };
+
+    /** Bytes of input consumed by one operation. */
+    static constexpr size_t OP_BYTES = 4;
+
+    /** Decodes operations from raw bytes, OP_BYTES per operation; a trailing partial operation is ignored.
+    * @pre None
+    * @post None
+    * @param data The bytes.
+    * @param size Number of bytes.
+    * @return The operations, with every field already reduced to its valid range. */
+    static std::vector<Op> decode(const std::uint8_t* data, size_t size);
+
+    /** Makes a random sequence of operations.
+    * @pre None
+    * @post None
+    * @param seed Seed for the generator; the same seed gives the same sequence.
+    * @param count Number of operations.
+    * @return The operations. */
+    static std::vector<Op> randomOps(std::uint64_t seed, size_t count);
+
+    /** Applies the operations to every backend and the reference model, checking them after every step.
+    * @pre None
+    * @post None
+    * @param ops The operations.
+    * @param transcript If not nullptr, receives each step as a C++ statement on polynomials p0 and p1.
+    * @return An empty string if every check passed, otherwise a description of the first mismatch. */
+    static std::string run(const std::vector<Op>& ops, std::string* transcript = nullptr);
+
+    /** Shrinks a failing sequence: drops runs of operations, then simplifies the values and powers of the rest, for as
+    * long as the sequence still fails.
+    * @pre run(ops) fails.
+    * @post None
+    * @param ops The failing operations.
+    * @return A failing sequence from which no single operation can be dropped or simplified. */
+    static std::vector<Op> shrink(std::vector<Op> ops);
+
+    /** Writes operations as C++ statements on polynomials p0 and p1, for pasting into a repro. Removals are written with
+    * the power they removed and skipped operations as comments.
+    * @pre None
+    * @post None
+    * @param ops The operations.
+    * @return One statement per line. */
+    static std::string describe(const std::vector<Op>& ops);
+
+    /** Property check: runs random sequences and reports the first failure, shrunk.
+    * @pre None
+    * @post None
+    * @param seed Seed of the first run; run i uses seed + i.
+    * @param runs Number of sequences.
+    * @param length Operations per sequence.
+    * @return An empty string if every run passed, otherwise the mismatch and the shrunk repro. */
+    static std::string check(std::uint64_t seed, size_t runs, size_t length);
+
+private:
+    /** Largest power an operation writes directly; products can reach MAX_DEGREE. */
+    static constexpr unsigned int MAX_POWER = 48;
+
+    /** Operations whose reference result would pass this degree are skipped, keeping runs fast. */
+    static constexpr unsigned int MAX_DEGREE = 384;
+
+    /** Operations whose reference result would hold a larger coefficient are skipped, so nothing overflows. */
+    static constexpr long long COEFFICIENT_LIMIT = 1LL << 20;
+
+    /** Dense reference polynomial: coefficient i belongs to power i, with no trailing zeros. */
+    struct Reference
+    {
+        std::vector<long long> coefficients;
+        char variable;
+
+        Reference();
+        void trim();
+        unsigned int termCount() const;
+        long long largest() const;
+    };
+
+    /** The two operands in every backend. */
+    struct Operands;
+
+    /** Checks one backend against the reference.
+    * @param poly The backend's polynomial.
+    * @param reference The reference polynomial.
+    * @param expected The reference as SparsePoly displays it.
+    * @param name Names the backend and operand in the report.
+    * @return An empty string if poly holds exactly the terms and variable of the reference. */
+    template <class Poly>
+    static std::string compare(const Poly& poly, const Reference& reference, const std::string& expected, const std::string& name);
+
+    /** Applies one operation to every backend and the reference.
+    * @param operands The polynomials.
+    * @param op The operation.
+    * @param statement Receives the operation as a C++ statement.
+    * @return An empty string if the step passed. */
+    static std::string step(Operands& operands, const Op& op, std::string& statement);
+
+    /** Checks every backend's copy of one operand.
+    * @return An empty string if they all match the reference. */
+    static std::string verify(const Operands& operands, unsigned int index);
+}; // end PolyDifferential
+
+#include "PolyDifferential.cpp"
+#endif
@@ -0,0 +1,270 @@
+/** @file PolyExpr.cpp
+* Lazy expression templates for sparse polynomial arithmetic. Each node either evaluates its operands directly at a value
+* of the variable or streams its terms into an accumulator that is combined once when the expression is assigned.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyExpr.h"
+#include <algorithm>
+#include <cstddef>
+
+// Returns the concrete expression node
+template <class Derived>
+const Derived& PolyExpr<Derived>::self() const
+{
+    return static_cast<const Derived&>(*this);
+}  // End self
+
+// Evaluates the expression at x
+template <class Derived>
+template <class D>
+typename D::value_type PolyExpr<Derived>::operator()(const typename D::value_type& x) const
+{
+    return evaluate(*this, x);
+}  // End operator()
+
+// Stores one term until the accumulator is finished
+template <class ItemType>
+void TermAccumulator<ItemType>::push(const ItemType& coefficient, unsigned int power)
+{
+    if (coefficient != 0)
+    {
+        pending.push_back(Node<ItemType>(coefficient, power));
+    } // End if
+}  // End push
+
+// Sorts and combines the collected terms
+template <class ItemType>
+void TermAccumulator<ItemType>::finish(std::vector<Node<ItemType>>& sortedTerms)
+{
+    sortedTerms.clear();
+
+    // Order by power from highest to lowest so equal powers are adjacent
+    std::stable_sort(pending.begin(), pending.end(),
+        [](const Node<ItemType>& a, const Node<ItemType>& b) { return a.getPower() > b.getPower(); });
+
+    size_t i = 0;
+    while (i < pending.size())
+    {
+        unsigned int power = pending[i].getPower();
+        ItemType sum = pending[i].getCoefficient();
+        i++;
+
+        // Combine all terms with the same power
+        while (i < pending.size() && pending[i].getPower() == power)
+        {
+            sum += pending[i].getCoefficient();
+            i++;
+        } // End while
+        if (sum != 0)
+        {
+            sortedTerms.push_back(Node<ItemType>(sum, power));
+        } // End if
+    } // End while
+    pending.clear();
+}  // End finish
+
+// Terminal constructor
+template <class ItemType>
+PolyTerminal<ItemType>::PolyTerminal(const SparsePoly<ItemType>& somePoly) : poly(somePoly)
+{ }  // End constructor
+
+template <class ItemType>
+char PolyTerminal<ItemType>::getVariable() const
+{
+    return poly.getVariable();
+}  // End getVariable
+
+template <class ItemType>
+bool PolyTerminal<ItemType>::isValid() const
+{
+    return true;
+}  // End isValid
+
+template <class ItemType>
+ItemType PolyTerminal<ItemType>::evaluateUnchecked(const ItemType& x) const
+{
+    return poly.evaluate(x);
+}  // End evaluateUnchecked
+
+// Streams the polynomial's terms with the scale folded into each coefficient load
+template <class ItemType>
+template <class Sink>
+void PolyTerminal<ItemType>::emitTerms(const ItemType& scale, Sink& sink) const
+{
+    poly.forEachTerm([&](const ItemType& coefficient, unsigned int power)
+    {
+        sink.push(coefficient * scale, power);
+    });
+}  // End emitTerms
+
+// Sum constructor
+template <class Left, class Right, bool Negate>
+PolySum<Left, Right, Negate>::PolySum(const Left& someLeft, const Right& someRight) : left(someLeft), right(someRight)
+{ }  // End constructor
+
+template <class Left, class Right, bool Negate>
+char PolySum<Left, Right, Negate>::getVariable() const
+{
+    return left.getVariable();
+}  // End getVariable
+
+template <class Left, class Right, bool Negate>
+bool PolySum<Left, Right, Negate>::isValid() const
+{
+    return left.isValid() && right.isValid() && left.getVariable() == right.getVariable();
+}  // End isValid
+
+template <class Left, class Right, bool Negate>
+typename PolySum<Left, Right, Negate>::value_type PolySum<Left, Right, Negate>::evaluateUnchecked(const value_type& x) const
+{
+    if (Negate)
+    {
+        return left.evaluateUnchecked(x) - right.evaluateUnchecked(x);
+    } // End if
+    return left.evaluateUnchecked(x) + right.evaluateUnchecked(x);
+}  // End evaluateUnchecked
+
+template <class Left, class Right, bool Negate>
+template <class Sink>
+void PolySum<Left, Right, Negate>::emitTerms(const value_type& scale, Sink& sink) const
+{
+    left.emitTerms(scale, sink);
+    if (Negate)
+    {
+        right.emitTerms(-scale, sink);
+    }
+    else
+    {
+        right.emitTerms(scale, sink);
+    } // End if
+}  // End emitTerms
+
+// Product constructor
+template <class Left, class Right>
+PolyProduct<Left, Right>::PolyProduct(const Left& someLeft, const Right& someRight) : left(someLeft), right(someRight)
+{ }  // End constructor
+
+template <class Left, class Right>
+char PolyProduct<Left, Right>::getVariable() const
+{
+    return left.getVariable();
+}  // End getVariable
+
+template <class Left, class Right>
+bool PolyProduct<Left, Right>::isValid() const
+{
+    return left.isValid() && right.isValid() && left.getVariable() == right.getVariable();
+}  // End isValid
+
+template <class Left, class Right>
+typename PolyProduct<Left, Right>::value_type PolyProduct<Left, Right>::evaluateUnchecked(const value_type& x) const
+{
+    return left.evaluateUnchecked(x) * right.evaluateUnchecked(x);
+}  // End evaluateUnchecked
+
+// Both operands are combined once into flat term arrays, multiplied by the same kernels as SparsePoly::multiply, and the
+// product terms are streamed to the sink
+template <class Left, class Right>
+template <class Sink>
+void PolyProduct<Left, Right>::emitTerms(const value_type& scale, Sink& sink) const
+{
+    std::vector<Node<value_type>> leftTerms;
+    std::vector<Node<value_type>> rightTerms;
+    TermAccumulator<value_type> accumulator;
+
+    left.emitTerms(scale, accumulator);
+    accumulator.finish(leftTerms);
+    right.emitTerms(static_cast<value_type>(1), accumulator);
+    accumulator.finish(rightTerms);
+
+    std::vector<Node<value_type>> product;
+    typename SparsePoly<value_type>::MultiplyBuffers buffers;
+    SparsePoly<value_type>::multiplyTerms(leftTerms, rightTerms, product, buffers);
+    for (const Node<value_type>& term : product)
+    {
+        sink.push(term.getCoefficient(), term.getPower());
+    } // End for
+}  // End emitTerms
+
+// Scaled constructor
+template <class Operand>
+PolyScaled<Operand>::PolyScaled(const Operand& someOperand, const value_type& someScalar) : operand(someOperand), scalar(someScalar)
+{ }  // End constructor
+
+template <class Operand>
+char PolyScaled<Operand>::getVariable() const
+{
+    return operand.getVariable();
+}  // End getVariable
+
+template <class Operand>
+bool PolyScaled<Operand>::isValid() const
+{
+    return operand.isValid();
+}  // End isValid
+
+template <class Operand>
+typename PolyScaled<Operand>::value_type PolyScaled<Operand>::evaluateUnchecked(const value_type& x) const
+{
+    return scalar * operand.evaluateUnchecked(x);
+}  // End evaluateUnchecked
+
+template <class Operand>
+template <class Sink>
+void PolyScaled<Operand>::emitTerms(const value_type& scale, Sink& sink) const
+{
+    operand.emitTerms(scale * scalar, sink);
+}  // End emitTerms
+
+// Evaluates an expression, matching add() and multiply() by giving 0 when the variables do not match
+template <class Expr>
+typename Expr::value_type evaluate(const PolyExpr<Expr>& expr, const typename Expr::value_type& x)
+{
+    const Expr& root = expr.self();
+    if (!root.isValid())
+    {
+        return 0;
+    } // End if
+    return root.evaluateUnchecked(x);
+}  // End evaluate
+
+template <class Left, class Right>
+EnableIfPolyOperands<Left, Right, PolySum<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type, false>>
+operator+(const Left& left, const Right& right)
+{
+    return PolySum<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type, false>(
+        PolyOperand<Left>::wrap(left), PolyOperand<Right>::wrap(right));
+}  // End operator+
+
+template <class Left, class Right>
+EnableIfPolyOperands<Left, Right, PolySum<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type, true>>
+operator-(const Left& left, const Right& right)
+{
+    return PolySum<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type, true>(
+        PolyOperand<Left>::wrap(left), PolyOperand<Right>::wrap(right));
+}  // End operator-
+
+template <class Left, class Right>
+EnableIfPolyOperands<Left, Right, PolyProduct<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type>>
+operator*(const Left& left, const Right& right)
+{
+    return PolyProduct<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type>(
+        PolyOperand<Left>::wrap(left), PolyOperand<Right>::wrap(right));
+}  // End operator*
+
+template <class Operand>
+EnableIfPolyOperands<Operand, Operand, PolyScaled<typename PolyOperand<Operand>::type>>
+operator*(const Operand& operand, const typename PolyOperand<Operand>::type::value_type& scalar)
+{
+    return PolyScaled<typename PolyOperand<Operand>::type>(PolyOperand<Operand>::wrap(operand), scalar);
+}  // End operator*
+
+template <class Operand>
+EnableIfPolyOperands<Operand, Operand, PolyScaled<typename PolyOperand<Operand>::type>>
+operator*(const typename PolyOperand<Operand>::type::value_type& scalar, const Operand& operand)
+{
+    return PolyScaled<typename PolyOperand<Operand>::type>(PolyOperand<Operand>::wrap(operand), scalar);
+}  // End operator*
@@ -0,0 +1,269 @@
+/** @file PolyExpr.h
+* @class PolyExpr
+* Lazy expression templates for sparse polynomial arithmetic. The +, - and * operators on SparsePoly objects build a tree of
+* expression nodes instead of computing temporaries. The tree is evaluated in one fused pass when it is assigned to a
+* SparsePoly or evaluated at a value of the variable. Expressions hold references to the polynomials they were built from,
+* so they should be assigned or evaluated before those polynomials go out of scope.
+*/
+
+#ifndef POLY_EXPR_
+#define POLY_EXPR_
+
+#include "Node.h"
+#include <type_traits>
+#include <vector>
+
+template <class ItemType>
+class SparsePoly;
+
+/** Base of every expression node. Derived is the concrete node type. */
+template <class Derived>
+class PolyExpr
+{
+public:
+    /** Gets the concrete expression node.
+    * @pre None
+    * @post Does not change the expression.
+    * @return A reference to the derived node. */
+    const Derived& self() const;
+
+    /** Evaluates the expression at a given value of the variable without materializing any intermediate polynomial.
+    * @pre All polynomials referenced by the expression are still alive.
+    * @post Does not change the expression or its polynomials.
+    * @param x The value given for the variable.
+    * @return The value of the expression at x, or 0 if the variables in the expression do not match. */
+    template <class D = Derived>
+    typename D::value_type operator()(const typename D::value_type& x) const;
+}; // end PolyExpr
+
+/** Collects the terms produced by an expression and combines them into sorted order. */
+template <class ItemType>
+class TermAccumulator
+{
+private:
+    /** Terms in the order they were produced. */
+    std::vector<Node<ItemType>> pending;
+
+public:
+    /** Adds one term to the accumulator.
+    * @pre None
+    * @post The term is stored until finish is called.
+    * @param coefficient The coefficient of the term.
+    * @param power The power of the term. */
+    void push(const ItemType& coefficient, unsigned int power);
+
+    /** Sorts the collected terms by power from highest to lowest, combines equal powers and drops zero coefficients.
+    * @pre None
+    * @post The accumulator is emptied.
+    * @param sortedTerms Receives the combined terms. */
+    void finish(std::vector<Node<ItemType>>& sortedTerms);
+}; // end TermAccumulator
+
+/** Leaf of an expression, referring to an existing polynomial. */
+template <class ItemType>
+class PolyTerminal : public PolyExpr<PolyTerminal<ItemType>>
+{
+private:
+    /** The referenced polynomial. */
+    const SparsePoly<ItemType>& poly;
+
+public:
+    using value_type = ItemType;
+
+    /** Constructor
+    * @pre The polynomial outlives the expression.
+    * @post None
+    * @param somePoly The polynomial to refer to. */
+    explicit PolyTerminal(const SparsePoly<ItemType>& somePoly);
+
+    /** @return The variable of the referenced polynomial. */
+    char getVariable() const;
+
+    /** @return Always true, a single polynomial has a consistent variable. */
+    bool isValid() const;
+
+    /** Evaluates the referenced polynomial without checking variables.
+    * @param x The value given for the variable.
+    * @return The value of the polynomial at x. */
+    ItemType evaluateUnchecked(const ItemType& x) const;
+
+    /** Produces every term with the scale folded into the coefficient.
+    * @param scale Factor applied to each coefficient.
+    * @param sink Receives the terms through push(coefficient, power). */
+    template <class Sink>
+    void emitTerms(const ItemType& scale, Sink& sink) const;
+}; // end PolyTerminal
+
+/** Sum (or difference when Negate is true) of two expressions. */
+template <class Left, class Right, bool Negate>
+class PolySum : public PolyExpr<PolySum<Left, Right, Negate>>
+{
+private:
+    Left left;
+    Right right;
+
+public:
+    using value_type = typename Left::value_type;
+
+    /** Constructor
+    * @pre None
+    * @post None
+    * @param someLeft The left operand.
+    * @param someRight The right operand. */
+    PolySum(const Left& someLeft, const Right& someRight);
+
+    /** @return The variable of the left operand. */
+    char getVariable() const;
+
+    /** @return True if both operands are valid and use the same variable. */
+    bool isValid() const;
+
+    /** Evaluates both operands at x and combines the values, never materializing the sum.
+    * @param x The value given for the variable.
+    * @return The value of the expression at x. */
+    value_type evaluateUnchecked(const value_type& x) const;
+
+    /** Produces the terms of both operands, negating the right operand for a difference.
+    * @param scale Factor applied to each coefficient.
+    * @param sink Receives the terms through push(coefficient, power). */
+    template <class Sink>
+    void emitTerms(const value_type& scale, Sink& sink) const;
+}; // end PolySum
+
+/** Product of two expressions. */
+template <class Left, class Right>
+class PolyProduct : public PolyExpr<PolyProduct<Left, Right>>
+{
+private:
+    Left left;
+    Right right;
+
+public:
+    using value_type = typename Left::value_type;
+
+    /** Constructor
+    * @pre None
+    * @post None
+    * @param someLeft The left operand.
+    * @param someRight The right operand. */
+    PolyProduct(const Left& someLeft, const Right& someRight);
+
+    /** @return The variable of the left operand. */
+    char getVariable() const;
+
+    /** @return True if both operands are valid and use the same variable. */
+    bool isValid() const;
+
+    /** Evaluates both operands at x and multiplies the values, never materializing the product.
+    * @param x The value given for the variable.
+    * @return The value of the expression at x. */
+    value_type evaluateUnchecked(const value_type& x) const;
+
+    /** Produces the terms of the product, multiplied by SparsePoly's multiplyTerms so dense operands use the Karatsuba and
+    * vector kernels. The scale is folded into the left operand's coefficients.
+    * @param scale Factor applied to each coefficient.
+    * @param sink Receives the terms through push(coefficient, power). */
+    template <class Sink>
+    void emitTerms(const value_type& scale, Sink& sink) const;
+}; // end PolyProduct
+
+/** Expression multiplied by a scalar. The scalar is folded into the coefficient loads of the operand. */
+template <class Operand>
+class PolyScaled : public PolyExpr<PolyScaled<Operand>>
+{
+public:
+    using value_type = typename Operand::value_type;
+
+private:
+    Operand operand;
+    value_type scalar;
+
+public:
+    /** Constructor
+    * @pre None
+    * @post None
+    * @param someOperand The expression to scale.
+    * @param someScalar The scalar factor. */
+    PolyScaled(const Operand& someOperand, const value_type& someScalar);
+
+    /** @return The variable of the operand. */
+    char getVariable() const;
+
+    /** @return True if the operand is valid. */
+    bool isValid() const;
+
+    /** Evaluates the operand at x and scales the value.
+    * @param x The value given for the variable.
+    * @return The value of the expression at x. */
+    value_type evaluateUnchecked(const value_type& x) const;
+
+    /** Produces the operand's terms with the scalar multiplied into the scale.
+    * @param scale Factor applied to each coefficient.
+    * @param sink Receives the terms through push(coefficient, power). */
+    template <class Sink>
+    void emitTerms(const value_type& scale, Sink& sink) const;
+}; // end PolyScaled
+
+/** Evaluates an expression at a given value of the variable without materializing any intermediate polynomial.
+* @pre All polynomials referenced by the expression are still alive.
+* @post Does not change the expression or its polynomials.
+* @param expr The expression to evaluate.
+* @param x The value given for the variable.
+* @return The value of the expression at x, or 0 if the variables in the expression do not match. */
+template <class Expr>
+typename Expr::value_type evaluate(const PolyExpr<Expr>& expr, const typename Expr::value_type& x);
+
+/** Maps an operand type to the expression node that represents it. Polynomials become terminals and expressions stay as they are. */
+template <class T, class Enable = void>
+struct PolyOperand
+{
+    static const bool isOperand = false;
+}; // end PolyOperand
+
+template <class ItemType>
+struct PolyOperand<SparsePoly<ItemType>>
+{
+    static const bool isOperand = true;
+    using type = PolyTerminal<ItemType>;
+    static type wrap(const SparsePoly<ItemType>& poly) { return type(poly); }
+}; // end PolyOperand
+
+template <class T>
+struct PolyOperand<T, typename std::enable_if<std::is_base_of<PolyExpr<T>, T>::value>::type>
+{
+    static const bool isOperand = true;
+    using type = T;
+    static const type& wrap(const T& expr) { return expr; }
+}; // end PolyOperand
+
+/** Enables an operator only when both operands are polynomials or expressions. */
+template <class Left, class Right, class Result>
+using EnableIfPolyOperands = typename std::enable_if<PolyOperand<Left>::isOperand && PolyOperand<Right>::isOperand, Result>::type;
+
+/** Builds the lazy sum of two polynomials or expressions. */
+template <class Left, class Right>
+EnableIfPolyOperands<Left, Right, PolySum<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type, false>>
+operator+(const Left& left, const Right& right);
+
+/** Builds the lazy difference of two polynomials or expressions. */
+template <class Left, class Right>
+EnableIfPolyOperands<Left, Right, PolySum<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type, true>>
+operator-(const Left& left, const Right& right);
+
+/** Builds the lazy product of two polynomials or expressions. */
+template <class Left, class Right>
+EnableIfPolyOperands<Left, Right, PolyProduct<typename PolyOperand<Left>::type, typename PolyOperand<Right>::type>>
+operator*(const Left& left, const Right& right);
+
+/** Builds the lazy product of a polynomial or expression with a scalar on the right. */
+template <class Operand>
+EnableIfPolyOperands<Operand, Operand, PolyScaled<typename PolyOperand<Operand>::type>>
+operator*(const Operand& operand, const typename PolyOperand<Operand>::type::value_type& scalar);
+
+/** Builds the lazy product of a polynomial or expression with a scalar on the left. */
+template <class Operand>
+EnableIfPolyOperands<Operand, Operand, PolyScaled<typename PolyOperand<Operand>::type>>
+operator*(const typename PolyOperand<Operand>::type::value_type& scalar, const Operand& operand);
+
+#include "PolyExpr.cpp"
+#endif
@@ -0,0 +1,43 @@
+/** @file PolyFootprint.cpp
+* Memory accounting for polynomials and collections of polynomials. This file is included by its header, so the
+* non-template functions are inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyFootprint.h"
+
+inline PolyFootprint::PolyFootprint() : objectBytes(0), heapBytes(0), heapBlocks(0)
+{ }  // End default constructor
+
+inline PolyFootprint::PolyFootprint(size_t someObjectBytes, size_t someHeapBytes, size_t someHeapBlocks)
+    : objectBytes(someObjectBytes), heapBytes(someHeapBytes), heapBlocks(someHeapBlocks)
+{ }  // End constructor
+
+inline size_t PolyFootprint::totalBytes() const
+{
+    return objectBytes + heapBytes;
+}  // End totalBytes
+
+inline PolyFootprint& PolyFootprint::operator+=(const PolyFootprint& other)
+{
+    objectBytes += other.objectBytes;
+    heapBytes += other.heapBytes;
+    heapBlocks += other.heapBlocks;
+    return *this;
+}  // End operator+=
+
+// The elements live in the vector's buffer, so only their heap memory is added to it
+template <class Poly>
+PolyFootprint memoryFootprint(const std::vector<Poly>& polys)
+{
+    PolyFootprint total(sizeof(std::vector<Poly>), polys.capacity() * sizeof(Poly), polys.capacity() > 0 ? 1 : 0);
+    for (const Poly& poly : polys)
+    {
+        PolyFootprint element = poly.memoryFootprint();
+        total.heapBytes += element.heapBytes;
+        total.heapBlocks += element.heapBlocks;
+    } // End for
+    return total;
+}  // End memoryFootprint
@@ -0,0 +1,57 @@
+/** @file PolyFootprint.h
+* @class PolyFootprint
+* Memory used by a polynomial or a collection of polynomials, split into the bytes of the objects themselves and the
+* bytes they request from the heap. Heap bytes are exact request sizes; the allocator adds its own per-block overhead
+* on top, which can be estimated from heapBlocks.
+*/
+
+#ifndef POLY_FOOTPRINT_
+#define POLY_FOOTPRINT_
+
+#include <cstddef>
+#include <vector>
+
+class PolyFootprint
+{
+public:
+    /** Bytes of the objects themselves, including unused capacity of a containing vector. */
+    size_t objectBytes;
+
+    /** Bytes requested from the heap by the objects. */
+    size_t heapBytes;
+
+    /** Number of separate heap allocations. */
+    size_t heapBlocks;
+
+    /** Default constructor
+    * @pre None
+    * @post Every count is 0. */
+    PolyFootprint();
+
+    /** Constructor
+    * @pre None
+    * @post None
+    * @param someObjectBytes Bytes of the objects.
+    * @param someHeapBytes Bytes requested from the heap.
+    * @param someHeapBlocks Number of heap allocations. */
+    PolyFootprint(size_t someObjectBytes, size_t someHeapBytes, size_t someHeapBlocks);
+
+    /** @return objectBytes plus heapBytes. */
+    size_t totalBytes() const;
+
+    /** Adds another footprint to this one.
+    * @param other The footprint to add.
+    * @return A reference to this footprint. */
+    PolyFootprint& operator+=(const PolyFootprint& other);
+}; // end PolyFootprint
+
+/** Measures a vector of polynomials: the vector's own buffer (by capacity) plus the heap memory of every element.
+* @pre Poly provides memoryFootprint().
+* @post Does not change the polynomials.
+* @param polys The polynomials.
+* @return The footprint of the whole collection. */
+template <class Poly>
+PolyFootprint memoryFootprint(const std::vector<Poly>& polys);
+
+#include "PolyFootprint.cpp"
+#endif
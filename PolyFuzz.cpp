@@ -0,0 +1,25 @@
+/** @file PolyFuzz.cpp
+* libFuzzer entry point for the differential harness. Each input is decoded into an operation sequence that is run
+* against every backend; on a mismatch the sequence is shrunk, the repro printed, and the process aborted so the fuzzer
+* saves the input. Built on its own, never together with main.cpp (see README).
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyDifferential.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, size_t size)
+{
+    std::vector<PolyDifferential::Op> ops = PolyDifferential::decode(data, size);
+    if (!PolyDifferential::run(ops).empty())
+    {
+        std::vector<PolyDifferential::Op> minimal = PolyDifferential::shrink(ops);
+        std::fprintf(stderr, "%s\nRepro:\n%s", PolyDifferential::run(minimal).c_str(), PolyDifferential::describe(minimal).c_str());
+        std::abort();
+    } // End if
+    return 0;
+}  // End LLVMFuzzerTestOneInput
@@ -0,0 +1,237 @@
+/** @file PolyInstrumentation.cpp
+* Operation-level counters for SparsePoly. This file is included by its header, so every function is inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyInstrumentation.h"
+#include <algorithm>
+
+// Snapshot constructor
+inline PolyCountersSnapshot::PolyCountersSnapshot()
+{
+    for (size_t op = 0; op < PolyInstrumentation::OPERATION_COUNT; op++)
+    {
+        for (size_t metric = 0; metric < PolyInstrumentation::METRIC_COUNT; metric++)
+        {
+            values[op][metric] = 0;
+        } // End for
+    } // End for
+}  // End constructor
+
+inline std::uint64_t PolyCountersSnapshot::get(PolyOperation operation, PolyMetric metric) const
+{
+    return values[static_cast<size_t>(operation)][static_cast<size_t>(metric)];
+}  // End get
+
+inline void PolyCountersSnapshot::add(PolyOperation operation, PolyMetric metric, std::uint64_t amount)
+{
+    values[static_cast<size_t>(operation)][static_cast<size_t>(metric)] += amount;
+}  // End add
+
+// Formats the snapshot as JSON
+inline std::string PolyCountersSnapshot::toJson() const
+{
+    std::string json = "{";
+    bool firstOperation = true;
+    for (size_t op = 0; op < PolyInstrumentation::OPERATION_COUNT; op++)
+    {
+        if (values[op][static_cast<size_t>(PolyMetric::Calls)] == 0)
+        {
+            continue;
+        } // End if
+        if (!firstOperation)
+        {
+            json += ",";
+        } // End if
+        firstOperation = false;
+        json += "\"" + std::string(PolyInstrumentation::operationName(static_cast<PolyOperation>(op))) + "\":{";
+        for (size_t metric = 0; metric < PolyInstrumentation::METRIC_COUNT; metric++)
+        {
+            if (metric > 0)
+            {
+                json += ",";
+            } // End if
+            json += "\"" + std::string(PolyInstrumentation::metricName(static_cast<PolyMetric>(metric))) + "\":" + std::to_string(values[op][metric]);
+        } // End for
+        json += "}";
+    } // End for
+    json += "}";
+    return json;
+}  // End toJson
+
+// Formats the snapshot in the Prometheus text format
+inline std::string PolyCountersSnapshot::toPrometheus() const
+{
+    static const char* const FAMILIES[] = { "sparse_poly_calls_total", "sparse_poly_nodes_traversed_total",
+        "sparse_poly_nodes_allocated_total", "sparse_poly_nodes_freed_total", "sparse_poly_bytes_allocated_total",
+        "sparse_poly_bytes_freed_total", "sparse_poly_time_nanoseconds_total" };
+
+    std::string text;
+    for (size_t metric = 0; metric < PolyInstrumentation::METRIC_COUNT; metric++)
+    {
+        text += "# HELP " + std::string(FAMILIES[metric]) + " SparsePoly " + PolyInstrumentation::metricName(static_cast<PolyMetric>(metric)) + " by operation.\n";
+        text += "# TYPE " + std::string(FAMILIES[metric]) + " counter\n";
+        for (size_t op = 0; op < PolyInstrumentation::OPERATION_COUNT; op++)
+        {
+            if (values[op][static_cast<size_t>(PolyMetric::Calls)] == 0)
+            {
+                continue;
+            } // End if
+            text += std::string(FAMILIES[metric]) + "{operation=\"" + PolyInstrumentation::operationName(static_cast<PolyOperation>(op))
+                + "\"} " + std::to_string(values[op][metric]) + "\n";
+        } // End for
+    } // End for
+    return text;
+}  // End toPrometheus
+
+// Thread counters constructor registers with the snapshot registry
+inline PolyThreadCounters::PolyThreadCounters() : current(PolyOperation::Count)
+{
+    for (size_t op = 0; op < PolyInstrumentation::OPERATION_COUNT; op++)
+    {
+        for (size_t metric = 0; metric < PolyInstrumentation::METRIC_COUNT; metric++)
+        {
+            values[op][metric].store(0, std::memory_order_relaxed);
+        } // End for
+    } // End for
+    PolyInstrumentation::Registry& shared = PolyInstrumentation::registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    shared.threads.push_back(this);
+}  // End constructor
+
+// Thread counters destructor keeps the totals of the exiting thread
+inline PolyThreadCounters::~PolyThreadCounters()
+{
+    PolyInstrumentation::Registry& shared = PolyInstrumentation::registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    addTo(shared.finished);
+    shared.threads.erase(std::remove(shared.threads.begin(), shared.threads.end(), this), shared.threads.end());
+}  // End destructor
+
+inline void PolyThreadCounters::add(PolyMetric metric, std::uint64_t amount)
+{
+    if (current != PolyOperation::Count)
+    {
+        add(current, metric, amount);
+    } // End if
+}  // End add
+
+// Only the owning thread writes, so a relaxed load and store is enough and avoids a locked read-modify-write
+inline void PolyThreadCounters::add(PolyOperation operation, PolyMetric metric, std::uint64_t amount)
+{
+    std::atomic<std::uint64_t>& counter = values[static_cast<size_t>(operation)][static_cast<size_t>(metric)];
+    counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}  // End add
+
+inline PolyOperation PolyThreadCounters::enter(PolyOperation operation)
+{
+    PolyOperation previous = current;
+    current = operation;
+    return previous;
+}  // End enter
+
+inline void PolyThreadCounters::leave(PolyOperation previous)
+{
+    current = previous;
+}  // End leave
+
+inline void PolyThreadCounters::addTo(PolyCountersSnapshot& snapshot) const
+{
+    for (size_t op = 0; op < PolyInstrumentation::OPERATION_COUNT; op++)
+    {
+        for (size_t metric = 0; metric < PolyInstrumentation::METRIC_COUNT; metric++)
+        {
+            snapshot.add(static_cast<PolyOperation>(op), static_cast<PolyMetric>(metric), values[op][metric].load(std::memory_order_relaxed));
+        } // End for
+    } // End for
+}  // End addTo
+
+inline PolyInstrumentation::Registry& PolyInstrumentation::registry()
+{
+    static Registry shared;
+    return shared;
+}  // End registry
+
+inline bool PolyInstrumentation::isEnabled()
+{
+#ifdef SPARSE_POLY_INSTRUMENTATION
+    return true;
+#else
+    return false;
+#endif
+}  // End isEnabled
+
+inline PolyThreadCounters& PolyInstrumentation::threadCounters()
+{
+    static thread_local PolyThreadCounters counters;
+    return counters;
+}  // End threadCounters
+
+// Sums every live thread and every finished thread, less the totals at the last reset
+inline PolyCountersSnapshot PolyInstrumentation::snapshot()
+{
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    PolyCountersSnapshot totals = shared.finished;
+    for (const PolyThreadCounters* counters : shared.threads)
+    {
+        counters->addTo(totals);
+    } // End for
+    for (size_t op = 0; op < PolyInstrumentation::OPERATION_COUNT; op++)
+    {
+        for (size_t metric = 0; metric < PolyInstrumentation::METRIC_COUNT; metric++)
+        {
+            PolyOperation operation = static_cast<PolyOperation>(op);
+            PolyMetric which = static_cast<PolyMetric>(metric);
+            totals.add(operation, which, 0 - shared.baseline.get(operation, which));
+        } // End for
+    } // End for
+    return totals;
+}  // End snapshot
+
+// Remembers the current totals so later snapshots start from 0
+inline void PolyInstrumentation::reset()
+{
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> guard(shared.lock);
+    PolyCountersSnapshot totals = shared.finished;
+    for (const PolyThreadCounters* counters : shared.threads)
+    {
+        counters->addTo(totals);
+    } // End for
+    shared.baseline = totals;
+}  // End reset
+
+inline const char* PolyInstrumentation::operationName(PolyOperation operation)
+{
+    static const char* const NAMES[] = { "copy", "changeCoefficient", "removeTerm", "coefficient", "degree", "clear",
+        "displayPoly", "assignTerms", "add", "multiply", "scalarMultiply", "evaluate", "evaluateDerivatives", "pow", "powMod",
+        "derivative", "integral", "taylorShift", "compose", "mulTrunc", "powTrunc", "inverseTrunc", "expressionAssign", "equals" };
+    return NAMES[static_cast<size_t>(operation)];
+}  // End operationName
+
+inline const char* PolyInstrumentation::metricName(PolyMetric metric)
+{
+    static const char* const NAMES[] = { "calls", "nodesTraversed", "nodesAllocated", "nodesFreed", "bytesAllocated",
+        "bytesFreed", "nanoseconds" };
+    return NAMES[static_cast<size_t>(metric)];
+}  // End metricName
+
+// Scope guard constructor
+inline PolyOperationScope::PolyOperationScope(PolyOperation someOperation)
+    : counters(PolyInstrumentation::threadCounters()), operation(someOperation)
+{
+    counters.add(operation, PolyMetric::Calls, 1);
+    previous = counters.enter(operation);
+    start = std::chrono::steady_clock::now();
+}  // End constructor
+
+// Scope guard destructor
+inline PolyOperationScope::~PolyOperationScope()
+{
+    std::chrono::nanoseconds elapsed = std::chrono::steady_clock::now() - start;
+    counters.add(operation, PolyMetric::Nanoseconds, static_cast<std::uint64_t>(elapsed.count()));
+    counters.leave(previous);
+}  // End destructor
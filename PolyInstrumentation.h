@@ -0,0 +1,246 @@
+/** @file PolyInstrumentation.h
+* @class PolyInstrumentation
+* Optional operation-level counters for SparsePoly. Define SPARSE_POLY_INSTRUMENTATION before including SparsePoly.h (or
+* in the project's preprocessor definitions) to turn the hooks on. Without it the POLY_INSTRUMENT_* macros expand to
+* nothing and the counters always read 0.
+*
+* Each thread counts into its own counters, which are only summed when a snapshot is taken. Work done inside an operation,
+* such as the nodes traversed by a changeCoefficient call made from add, is charged to the innermost operation, while
+* the time of an operation includes the operations it calls.
+*/
+
+#ifndef POLY_INSTRUMENTATION_
+#define POLY_INSTRUMENTATION_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** Operations that are counted separately. */
+enum class PolyOperation
+{
+    Copy,
+    ChangeCoefficient,
+    RemoveTerm,
+    Coefficient,
+    Degree,
+    Clear,
+    DisplayPoly,
+    AssignTerms,
+    Add,
+    Multiply,
+    ScalarMultiply,
+    Evaluate,
+    EvaluateDerivatives,
+    Pow,
+    PowMod,
+    Derivative,
+    Integral,
+    TaylorShift,
+    Compose,
+    MulTrunc,
+    PowTrunc,
+    InverseTrunc,
+    ExpressionAssign,
+    Equals,
+    Count
+};
+
+/** Quantities recorded for every operation. */
+enum class PolyMetric
+{
+    Calls,
+    NodesTraversed,
+    NodesAllocated,
+    NodesFreed,
+    BytesAllocated,
+    BytesFreed,
+    Nanoseconds,
+    Count
+};
+
+/** Totals of every metric for every operation at one point in time. */
+class PolyCountersSnapshot
+{
+private:
+    /** Values indexed by operation, then by metric. */
+    std::uint64_t values[static_cast<size_t>(PolyOperation::Count)][static_cast<size_t>(PolyMetric::Count)];
+
+public:
+    /** Default constructor
+    * @pre None
+    * @post Every counter is 0. */
+    PolyCountersSnapshot();
+
+    /** Gets one counter.
+    * @pre None
+    * @post Does not change the snapshot.
+    * @param operation The operation.
+    * @param metric The metric.
+    * @return The value of the counter. */
+    std::uint64_t get(PolyOperation operation, PolyMetric metric) const;
+
+    /** Adds to one counter.
+    * @pre None
+    * @post The counter is increased by amount.
+    * @param operation The operation.
+    * @param metric The metric.
+    * @param amount The amount to add; subtraction wraps like any unsigned counter. */
+    void add(PolyOperation operation, PolyMetric metric, std::uint64_t amount);
+
+    /** Formats the snapshot as a JSON object keyed by operation name. Operations that were never called are left out.
+    * @pre None
+    * @post Does not change the snapshot.
+    * @return The JSON text. */
+    std::string toJson() const;
+
+    /** Formats the snapshot in the Prometheus text exposition format, one counter family per metric labelled by operation.
+    * @pre None
+    * @post Does not change the snapshot.
+    * @return The exposition text. */
+    std::string toPrometheus() const;
+}; // end PolyCountersSnapshot
+
+/** Counters owned by one thread. Only the owning thread writes them; snapshots read them with relaxed atomics. */
+class PolyThreadCounters
+{
+private:
+    std::atomic<std::uint64_t> values[static_cast<size_t>(PolyOperation::Count)][static_cast<size_t>(PolyMetric::Count)];
+
+    /** The operation that nodes and bytes are currently charged to. */
+    PolyOperation current;
+
+public:
+    /** Constructor that registers the counters for snapshots.
+    * @pre None
+    * @post None */
+    PolyThreadCounters();
+
+    /** Destructor that folds the counters into the totals of finished threads.
+    * @pre None
+    * @post None */
+    ~PolyThreadCounters();
+
+    PolyThreadCounters(const PolyThreadCounters&) = delete;
+    PolyThreadCounters& operator=(const PolyThreadCounters&) = delete;
+
+    /** Adds to a counter of the current operation.
+    * @param metric The metric.
+    * @param amount The amount to add. */
+    void add(PolyMetric metric, std::uint64_t amount);
+
+    /** Adds to a counter of a given operation.
+    * @param operation The operation.
+    * @param metric The metric.
+    * @param amount The amount to add. */
+    void add(PolyOperation operation, PolyMetric metric, std::uint64_t amount);
+
+    /** Makes an operation current.
+    * @param operation The new current operation.
+    * @return The operation that was current before. */
+    PolyOperation enter(PolyOperation operation);
+
+    /** Restores the operation that was current before enter.
+    * @param previous The operation returned by enter. */
+    void leave(PolyOperation previous);
+
+    /** Adds this thread's counters into a snapshot.
+    * @param snapshot The snapshot to add to. */
+    void addTo(PolyCountersSnapshot& snapshot) const;
+}; // end PolyThreadCounters
+
+class PolyInstrumentation
+{
+private:
+    /** Shared state behind the snapshot API. */
+    struct Registry
+    {
+        std::mutex lock;
+        std::vector<const PolyThreadCounters*> threads;
+        PolyCountersSnapshot finished; // Totals of threads that have exited
+        PolyCountersSnapshot baseline; // Totals at the last reset
+    };
+
+    /** @return The process wide registry. */
+    static Registry& registry();
+
+    friend class PolyThreadCounters;
+
+public:
+    /** Number of operations that are counted. */
+    static constexpr size_t OPERATION_COUNT = static_cast<size_t>(PolyOperation::Count);
+
+    /** Number of metrics recorded per operation. */
+    static constexpr size_t METRIC_COUNT = static_cast<size_t>(PolyMetric::Count);
+
+    /** @return True if the library was built with SPARSE_POLY_INSTRUMENTATION. */
+    static bool isEnabled();
+
+    /** @return The counters of the calling thread. */
+    static PolyThreadCounters& threadCounters();
+
+    /** Sums the counters of every thread since the last reset.
+    * @pre None
+    * @post Does not change the counters.
+    * @return The totals. */
+    static PolyCountersSnapshot snapshot();
+
+    /** Starts counting from 0 again. Threads keep counting while the reset happens; their earlier totals are remembered and subtracted from later snapshots.
+    * @pre None
+    * @post The next snapshot only holds work done after the reset. */
+    static void reset();
+
+    /** Gets the name used for an operation in the JSON and Prometheus output.
+    * @param operation The operation.
+    * @return The name, e.g. "changeCoefficient". */
+    static const char* operationName(PolyOperation operation);
+
+    /** Gets the name used for a metric in the JSON and Prometheus output.
+    * @param metric The metric.
+    * @return The name, e.g. "nodesTraversed". */
+    static const char* metricName(PolyMetric metric);
+}; // end PolyInstrumentation
+
+/** Scope guard that counts one call of an operation, makes it current for node and byte counts, and adds its elapsed time. */
+class PolyOperationScope
+{
+private:
+    PolyThreadCounters& counters;
+    PolyOperation operation;
+    PolyOperation previous;
+    std::chrono::steady_clock::time_point start;
+
+public:
+    /** Constructor that starts the operation.
+    * @param someOperation The operation being entered. */
+    explicit PolyOperationScope(PolyOperation someOperation);
+
+    /** Destructor that records the elapsed time and restores the previous operation. */
+    ~PolyOperationScope();
+
+    PolyOperationScope(const PolyOperationScope&) = delete;
+    PolyOperationScope& operator=(const PolyOperationScope&) = delete;
+}; // end PolyOperationScope
+
+#ifdef SPARSE_POLY_INSTRUMENTATION
+#define POLY_INSTRUMENT_OPERATION(operation) PolyOperationScope polyOperationScope(PolyOperation::operation)
+#define POLY_INSTRUMENT_TRAVERSE(count) PolyInstrumentation::threadCounters().add(PolyMetric::NodesTraversed, static_cast<std::uint64_t>(count))
+#define POLY_INSTRUMENT_ALLOCATE(count, bytes) \
+    (PolyInstrumentation::threadCounters().add(PolyMetric::NodesAllocated, static_cast<std::uint64_t>(count)), \
+     PolyInstrumentation::threadCounters().add(PolyMetric::BytesAllocated, static_cast<std::uint64_t>(bytes)))
+#define POLY_INSTRUMENT_FREE(count, bytes) \
+    (PolyInstrumentation::threadCounters().add(PolyMetric::NodesFreed, static_cast<std::uint64_t>(count)), \
+     PolyInstrumentation::threadCounters().add(PolyMetric::BytesFreed, static_cast<std::uint64_t>(bytes)))
+#else
+#define POLY_INSTRUMENT_OPERATION(operation) ((void)0)
+#define POLY_INSTRUMENT_TRAVERSE(count) ((void)0)
+#define POLY_INSTRUMENT_ALLOCATE(count, bytes) ((void)0)
+#define POLY_INSTRUMENT_FREE(count, bytes) ((void)0)
+#endif
+
+#include "PolyInstrumentation.cpp"
+#endif
@@ -0,0 +1,122 @@
+/** @file PolyIntern.cpp
+* Interning table of canonical SparsePoly copies, bucketed by the polynomial hash.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyIntern.h"
+#include <utility>
+
+// Default constructor
+template <class ItemType>
+PolyInternTable<ItemType>::PolyInternTable() : count(0)
+{ }  // End default constructor
+
+// Searches the bucket of the hash for an equal polynomial
+template <class ItemType>
+typename PolyInternTable<ItemType>::Handle PolyInternTable<ItemType>::findLocked(const SparsePoly<ItemType>& poly, std::uint64_t hash) const
+{
+    auto bucket = buckets.find(hash);
+    if (bucket == buckets.end())
+    {
+        return nullptr;
+    } // End if
+    for (const Handle& stored : bucket->second)
+    {
+        if (*stored == poly)
+        {
+            return stored;
+        } // End if
+    } // End for
+    return nullptr;
+}  // End findLocked
+
+// Interns a copy of the polynomial
+template <class ItemType>
+typename PolyInternTable<ItemType>::Handle PolyInternTable<ItemType>::intern(const SparsePoly<ItemType>& poly)
+{
+    const std::uint64_t hash = poly.hash();
+    std::lock_guard<std::mutex> guard(lock);
+    Handle stored = findLocked(poly, hash);
+    if (stored == nullptr)
+    {
+        stored = std::make_shared<const SparsePoly<ItemType>>(poly);
+        buckets[hash].push_back(stored);
+        count++;
+    } // End if
+    return stored;
+}  // End intern
+
+// Interns the polynomial, moving it in if it is new
+template <class ItemType>
+typename PolyInternTable<ItemType>::Handle PolyInternTable<ItemType>::intern(SparsePoly<ItemType>&& poly)
+{
+    const std::uint64_t hash = poly.hash();
+    std::lock_guard<std::mutex> guard(lock);
+    Handle stored = findLocked(poly, hash);
+    if (stored == nullptr)
+    {
+        stored = std::make_shared<const SparsePoly<ItemType>>(std::move(poly));
+        buckets[hash].push_back(stored);
+        count++;
+    } // End if
+    return stored;
+}  // End intern
+
+// Looks up the canonical copy without storing
+template <class ItemType>
+typename PolyInternTable<ItemType>::Handle PolyInternTable<ItemType>::find(const SparsePoly<ItemType>& poly) const
+{
+    const std::uint64_t hash = poly.hash();
+    std::lock_guard<std::mutex> guard(lock);
+    return findLocked(poly, hash);
+}  // End find
+
+// Returns the number of distinct polynomials
+template <class ItemType>
+size_t PolyInternTable<ItemType>::size() const
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return count;
+}  // End size
+
+// Drops the copies only the table still holds
+template <class ItemType>
+size_t PolyInternTable<ItemType>::prune()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    size_t dropped = 0;
+    for (auto bucket = buckets.begin(); bucket != buckets.end();)
+    {
+        std::vector<Handle>& copies = bucket->second;
+        for (size_t i = copies.size(); i > 0; i--)
+        {
+            if (copies[i - 1].use_count() == 1)
+            {
+                copies[i - 1] = std::move(copies.back());
+                copies.pop_back();
+                dropped++;
+            } // End if
+        } // End for
+        if (copies.empty())
+        {
+            bucket = buckets.erase(bucket);
+        }
+        else
+        {
+            ++bucket;
+        } // End if
+    } // End for
+    count -= dropped;
+    return dropped;
+}  // End prune
+
+// Drops every copy
+template <class ItemType>
+void PolyInternTable<ItemType>::clear()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    buckets.clear();
+    count = 0;
+}  // End clear
@@ -0,0 +1,93 @@
+/** @file PolyIntern.h
+* @class PolyInternTable
+* Deduplicating store for SparsePoly values. Interning a polynomial returns a shared, read-only canonical copy: the first
+* polynomial with given terms and variable is stored, and every equal polynomial interned later gets that same copy back.
+* Lookups go through the incremental hash of SparsePoly, so a polynomial is only compared term by term with stored
+* polynomials of the same hash. The table may be used from several threads at once.
+*/
+
+#ifndef POLY_INTERN_
+#define POLY_INTERN_
+
+#include "SparsePoly.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+template <class ItemType>
+class PolyInternTable
+{
+public:
+    using Handle = std::shared_ptr<const SparsePoly<ItemType>>;
+
+private:
+    /** Canonical copies keyed by hash. The copies in one bucket all differ; more than one only on a hash collision. */
+    std::unordered_map<std::uint64_t, std::vector<Handle>> buckets;
+
+    /** Number of canonical copies stored. */
+    size_t count;
+
+    /** Guards buckets and count. */
+    mutable std::mutex lock;
+
+    /** Helper that looks up the canonical copy of a polynomial.
+    * @pre The caller holds lock.
+    * @post Does not change the table.
+    * @param poly The polynomial to look up.
+    * @param hash The hash of poly.
+    * @return The canonical copy, or nullptr if no equal polynomial is stored. */
+    Handle findLocked(const SparsePoly<ItemType>& poly, std::uint64_t hash) const;
+
+public:
+    /** Default constructor
+    * @pre None
+    * @post The table is empty. */
+    PolyInternTable();
+
+    PolyInternTable(const PolyInternTable&) = delete;
+    PolyInternTable& operator=(const PolyInternTable&) = delete;
+
+    /** Returns the canonical copy of a polynomial, storing a copy of it if no equal polynomial is stored yet.
+    * @pre None
+    * @post The table holds a polynomial equal to poly.
+    * @param poly The polynomial to intern.
+    * @return The canonical copy. */
+    Handle intern(const SparsePoly<ItemType>& poly);
+
+    /** Returns the canonical copy of a polynomial, moving the polynomial into the table if no equal polynomial is stored yet.
+    * @pre None
+    * @post The table holds a polynomial equal to poly. poly is left empty if it was moved in.
+    * @param poly The polynomial to intern.
+    * @return The canonical copy. */
+    Handle intern(SparsePoly<ItemType>&& poly);
+
+    /** Looks up the canonical copy of a polynomial without storing anything.
+    * @pre None
+    * @post Does not change the table.
+    * @param poly The polynomial to look up.
+    * @return The canonical copy, or nullptr if no equal polynomial is stored. */
+    Handle find(const SparsePoly<ItemType>& poly) const;
+
+    /** Retrieves the number of distinct polynomials stored.
+    * @pre None
+    * @post Does not change the table.
+    * @return The number of canonical copies. */
+    size_t size() const;
+
+    /** Drops the canonical copies that no handle outside the table refers to any more.
+    * @pre None
+    * @post Every remaining copy is held by at least one handle outside the table.
+    * @return The number of copies dropped. */
+    size_t prune();
+
+    /** Drops every canonical copy. Handles already returned stay valid.
+    * @pre None
+    * @post The table is empty. */
+    void clear();
+}; // end PolyInternTable
+
+#include "PolyIntern.cpp"
+#endif
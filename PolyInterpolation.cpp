@@ -0,0 +1,535 @@
+/** @file PolyInterpolation.cpp
+* Dense interpolation in Newton form and sparse Ben-Or/Tiwari interpolation modulo a prime. This file is included
+* by its header, so the non-template functions are inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyInterpolation.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <utility>
+
+inline std::uint64_t PolyPrimeField::add(std::uint64_t a, std::uint64_t b)
+{
+    std::uint64_t sum = a + b;
+    return (sum >= PRIME) ? sum - PRIME : sum;
+}  // End add
+
+inline std::uint64_t PolyPrimeField::subtract(std::uint64_t a, std::uint64_t b)
+{
+    return (a >= b) ? a - b : a + PRIME - b;
+}  // End subtract
+
+inline std::uint64_t PolyPrimeField::multiply(std::uint64_t a, std::uint64_t b)
+{
+    return (a * b) % PRIME;
+}  // End multiply
+
+inline std::uint64_t PolyPrimeField::power(std::uint64_t base, std::uint64_t exponent)
+{
+    std::uint64_t result = 1;
+    base %= PRIME;
+    while (exponent > 0)
+    {
+        if (exponent & 1)
+        {
+            result = multiply(result, base);
+        } // End if
+        base = multiply(base, base);
+        exponent >>= 1;
+    } // End while
+    return result;
+}  // End power
+
+inline std::uint64_t PolyPrimeField::inverse(std::uint64_t a)
+{
+    return power(a, PRIME - 2);
+}  // End inverse
+
+inline std::uint64_t PolyPrimeField::fromInteger(long long value)
+{
+    long long residue = value % static_cast<long long>(PRIME);
+    return static_cast<std::uint64_t>((residue < 0) ? residue + static_cast<long long>(PRIME) : residue);
+}  // End fromInteger
+
+inline long long PolyPrimeField::toInteger(std::uint64_t residue)
+{
+    return (residue > PRIME / 2) ? static_cast<long long>(residue) - static_cast<long long>(PRIME) : static_cast<long long>(residue);
+}  // End toInteger
+
+// Solves the logarithm modulo each prime power of PRIME - 1 = 2^27 * 3 * 5 one digit at a time, then joins them by the Chinese remainder theorem
+inline std::uint64_t PolyPrimeField::discreteLog(std::uint64_t a)
+{
+    const std::uint64_t order = PRIME - 1;
+    const std::uint64_t factors[][2] = { { 2, 27 }, { 3, 1 }, { 5, 1 } };
+    std::uint64_t result = 0;
+    for (const auto& factor : factors)
+    {
+        const std::uint64_t q = factor[0];
+        std::uint64_t modulus = 1;
+        for (std::uint64_t i = 0; i < factor[1]; i++)
+        {
+            modulus *= q;
+        } // End for
+
+        // Work in the subgroup of order q^k, where gamma has order q
+        const std::uint64_t base = power(GENERATOR, order / modulus);
+        const std::uint64_t target = power(a, order / modulus);
+        const std::uint64_t gamma = power(base, modulus / q);
+        std::uint64_t logarithm = 0;
+        std::uint64_t digitWeight = 1;
+        for (std::uint64_t i = 0; i < factor[1]; i++)
+        {
+            const std::uint64_t remaining = multiply(inverse(power(base, logarithm)), target);
+            const std::uint64_t digitValue = power(remaining, modulus / (digitWeight * q));
+            std::uint64_t digit = 0;
+            for (std::uint64_t candidate = 1; digit < q && candidate != digitValue; digit++)
+            {
+                candidate = multiply(candidate, gamma);
+            } // End for
+            logarithm += digit * digitWeight;
+            digitWeight *= q;
+        } // End for
+
+        // Inverse of order / modulus modulo modulus by the extended Euclidean algorithm
+        const std::uint64_t cofactor = order / modulus;
+        long long r0 = static_cast<long long>(modulus), r1 = static_cast<long long>(cofactor % modulus);
+        long long s0 = 0, s1 = 1;
+        while (r1 != 0)
+        {
+            long long quotient = r0 / r1;
+            std::swap(r0, r1);
+            r1 -= quotient * r0;
+            std::swap(s0, s1);
+            s1 -= quotient * s0;
+        } // End while
+        const std::uint64_t cofactorInverse = static_cast<std::uint64_t>((s0 % static_cast<long long>(modulus) + static_cast<long long>(modulus)) % static_cast<long long>(modulus));
+        result = (result + (logarithm * cofactorInverse % modulus) * cofactor) % order;
+    } // End for
+    return result;
+}  // End discreteLog
+
+// Workers claim samples in chunks so cheap black boxes do not contend on the counter
+template <class ItemType>
+template <class Function, class Input, class Output>
+void PolyInterpolation<ItemType>::sampleParallel(Function& f, const std::vector<Input>& inputs, std::vector<Output>& outputs, unsigned int threadCount)
+{
+    outputs.resize(inputs.size());
+    const size_t chunks = (inputs.size() + SAMPLE_CHUNK - 1) / SAMPLE_CHUNK;
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    } // End if
+    threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, chunks));
+
+    std::atomic<size_t> nextChunk(0);
+    auto worker = [&]()
+    {
+        for (size_t chunk = nextChunk++; chunk < chunks; chunk = nextChunk++)
+        {
+            const size_t end = std::min(inputs.size(), (chunk + 1) * SAMPLE_CHUNK);
+            for (size_t i = chunk * SAMPLE_CHUNK; i < end; i++)
+            {
+                outputs[i] = f(inputs[i]);
+            } // End for
+        } // End for
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; t++)
+    {
+        threads.push_back(std::thread(worker));
+    } // End for
+    worker(); // The calling thread works too
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    } // End for
+}  // End sampleParallel
+
+template <class ItemType>
+typename PolyInterpolation<ItemType>::Residues PolyInterpolation<ItemType>::multiplyResidues(const Residues& a, const Residues& b)
+{
+    if (a.empty() || b.empty())
+    {
+        return Residues();
+    } // End if
+    Residues result(a.size() + b.size() - 1, 0);
+    for (size_t i = 0; i < a.size(); i++)
+    {
+        for (size_t j = 0; j < b.size(); j++)
+        {
+            result[i + j] = PolyPrimeField::add(result[i + j], PolyPrimeField::multiply(a[i], b[j]));
+        } // End for
+    } // End for
+    return result;
+}  // End multiplyResidues
+
+template <class ItemType>
+void PolyInterpolation<ItemType>::reduceResidues(Residues& dividend, const Residues& divisor)
+{
+    const size_t divisorDegree = divisor.size() - 1;
+    const std::uint64_t leadingInverse = PolyPrimeField::inverse(divisor[divisorDegree]);
+    for (size_t i = dividend.size(); i > divisorDegree; i--)
+    {
+        const size_t top = i - 1;
+        const std::uint64_t quotient = PolyPrimeField::multiply(dividend[top], leadingInverse);
+        if (quotient != 0)
+        {
+            const size_t offset = top - divisorDegree;
+            for (size_t j = 0; j < divisorDegree; j++)
+            {
+                dividend[offset + j] = PolyPrimeField::subtract(dividend[offset + j], PolyPrimeField::multiply(quotient, divisor[j]));
+            } // End for
+        } // End if
+        dividend.pop_back();
+    } // End for
+    while (!dividend.empty() && dividend.back() == 0)
+    {
+        dividend.pop_back();
+    } // End while
+}  // End reduceResidues
+
+template <class ItemType>
+typename PolyInterpolation<ItemType>::Residues PolyInterpolation<ItemType>::divideResidues(Residues dividend, const Residues& divisor)
+{
+    const size_t divisorDegree = divisor.size() - 1;
+    const std::uint64_t leadingInverse = PolyPrimeField::inverse(divisor[divisorDegree]);
+    Residues quotient(dividend.size() - divisorDegree, 0);
+    for (size_t i = dividend.size(); i > divisorDegree; i--)
+    {
+        const size_t offset = i - 1 - divisorDegree;
+        quotient[offset] = PolyPrimeField::multiply(dividend[i - 1], leadingInverse);
+        for (size_t j = 0; j <= divisorDegree; j++)
+        {
+            dividend[offset + j] = PolyPrimeField::subtract(dividend[offset + j], PolyPrimeField::multiply(quotient[offset], divisor[j]));
+        } // End for
+    } // End for
+    return quotient;
+}  // End divideResidues
+
+template <class ItemType>
+typename PolyInterpolation<ItemType>::Residues PolyInterpolation<ItemType>::gcdResidues(Residues a, Residues b)
+{
+    while (!b.empty())
+    {
+        reduceResidues(a, b);
+        a.swap(b);
+    } // End while
+    if (!a.empty())
+    {
+        const std::uint64_t leadingInverse = PolyPrimeField::inverse(a.back());
+        for (std::uint64_t& coefficient : a)
+        {
+            coefficient = PolyPrimeField::multiply(coefficient, leadingInverse);
+        } // End for
+    } // End if
+    return a;
+}  // End gcdResidues
+
+template <class ItemType>
+typename PolyInterpolation<ItemType>::Residues PolyInterpolation<ItemType>::berlekampMassey(const std::vector<std::uint64_t>& sequence)
+{
+    Residues connection{ 1 };
+    Residues previous{ 1 };
+    size_t length = 0;
+    size_t shift = 1;
+    std::uint64_t previousDiscrepancy = 1;
+    for (size_t n = 0; n < sequence.size(); n++)
+    {
+        std::uint64_t discrepancy = sequence[n];
+        for (size_t i = 1; i <= length && i < connection.size(); i++)
+        {
+            discrepancy = PolyPrimeField::add(discrepancy, PolyPrimeField::multiply(connection[i], sequence[n - i]));
+        } // End for
+        if (discrepancy == 0)
+        {
+            shift++;
+            continue;
+        } // End if
+
+        // connection -= (discrepancy / previousDiscrepancy) z^shift previous
+        const std::uint64_t scale = PolyPrimeField::multiply(discrepancy, PolyPrimeField::inverse(previousDiscrepancy));
+        Residues updated = connection;
+        if (updated.size() < previous.size() + shift)
+        {
+            updated.resize(previous.size() + shift, 0);
+        } // End if
+        for (size_t i = 0; i < previous.size(); i++)
+        {
+            updated[i + shift] = PolyPrimeField::subtract(updated[i + shift], PolyPrimeField::multiply(scale, previous[i]));
+        } // End for
+        if (2 * length <= n)
+        {
+            length = n + 1 - length;
+            previous.swap(connection);
+            previousDiscrepancy = discrepancy;
+            shift = 1;
+        }
+        else
+        {
+            shift++;
+        } // End if
+        connection.swap(updated);
+    } // End for
+
+    // Lambda(z) = z^length C(1 / z)
+    connection.resize(length + 1, 0);
+    return Residues(connection.rbegin(), connection.rend());
+}  // End berlekampMassey
+
+// For a random shift a, the roots r with r + a a square are the roots of gcd(f, (x + a)^((p - 1) / 2) - 1)
+template <class ItemType>
+void PolyInterpolation<ItemType>::findRoots(const Residues& poly, std::vector<std::uint64_t>& roots)
+{
+    const size_t degree = poly.size() - 1;
+    if (degree == 0)
+    {
+        return;
+    } // End if
+    if (degree == 1)
+    {
+        roots.push_back(PolyPrimeField::multiply(PolyPrimeField::subtract(0, poly[0]), PolyPrimeField::inverse(poly[1])));
+        return;
+    } // End if
+
+    // Each shift splits a pair of roots with probability about 1/2; a polynomial that does not split gives up eventually
+    for (std::uint64_t shift = 1; shift <= 64; shift++)
+    {
+        Residues result{ 1 };
+        Residues base{ shift, 1 };
+        reduceResidues(base, poly);
+        for (std::uint64_t exponent = (PolyPrimeField::PRIME - 1) / 2; exponent > 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+            {
+                result = multiplyResidues(result, base);
+                reduceResidues(result, poly);
+            } // End if
+            base = multiplyResidues(base, base);
+            reduceResidues(base, poly);
+        } // End for
+        if (result.empty())
+        {
+            result.push_back(0);
+        } // End if
+        result[0] = PolyPrimeField::subtract(result[0], 1);
+        while (!result.empty() && result.back() == 0)
+        {
+            result.pop_back();
+        } // End while
+
+        Residues factor = gcdResidues(poly, result);
+        if (factor.size() > 1 && factor.size() < poly.size())
+        {
+            findRoots(factor, roots);
+            findRoots(divideResidues(poly, factor), roots);
+            return;
+        } // End if
+    } // End for
+}  // End findRoots
+
+// Orders the points Leja style, takes divided differences in place, then expands the Newton form from the innermost factor out
+template <class ItemType>
+SparsePoly<ItemType> PolyInterpolation<ItemType>::interpolateNewton(const std::vector<ItemType>& points, const std::vector<ItemType>& values, char variable)
+{
+    SparsePoly<ItemType> result(variable);
+    const size_t n = points.size();
+    std::vector<ItemType> nodes = points;
+    std::vector<ItemType> differences = values;
+
+    // Start from the largest point, then repeatedly take the point with the largest product of distances to those taken
+    size_t largest = 0;
+    for (size_t i = 1; i < n; i++)
+    {
+        if (std::fabs(nodes[i]) > std::fabs(nodes[largest]))
+        {
+            largest = i;
+        } // End if
+    } // End for
+    std::swap(nodes[0], nodes[largest]);
+    std::swap(differences[0], differences[largest]);
+    std::vector<ItemType> distance(n, static_cast<ItemType>(1));
+    for (size_t k = 1; k < n; k++)
+    {
+        size_t best = k;
+        for (size_t i = k; i < n; i++)
+        {
+            distance[i] *= std::fabs(nodes[i] - nodes[k - 1]);
+            if (distance[i] > distance[best])
+            {
+                best = i;
+            } // End if
+        } // End for
+        std::swap(nodes[k], nodes[best]);
+        std::swap(differences[k], differences[best]);
+        std::swap(distance[k], distance[best]);
+    } // End for
+
+    // Every pair of points meets in one denominator, so coinciding points are always caught
+    for (size_t j = 1; j < n; j++)
+    {
+        for (size_t i = n - 1; i >= j; i--)
+        {
+            const ItemType gap = nodes[i] - nodes[i - j];
+            if (gap == 0)
+            {
+                return result;
+            } // End if
+            differences[i] = (differences[i] - differences[i - 1]) / gap;
+        } // End for
+    } // End for
+
+    std::vector<ItemType> dense{ differences[n - 1] };
+    dense.reserve(n);
+    for (size_t k = n - 1; k > 0; k--)
+    {
+        // dense <- dense * (x - nodes[k - 1]) + differences[k - 1]
+        dense.push_back(static_cast<ItemType>(0));
+        for (size_t i = dense.size() - 1; i > 0; i--)
+        {
+            dense[i] = dense[i - 1] - nodes[k - 1] * dense[i];
+        } // End for
+        dense[0] = differences[k - 1] - nodes[k - 1] * dense[0];
+    } // End for
+
+    std::vector<Node<ItemType>> terms;
+    for (size_t power = dense.size(); power > 0; power--)
+    {
+        if (!std::isfinite(dense[power - 1]))
+        {
+            // The monomial coefficients overflowed
+            return result;
+        } // End if
+        if (dense[power - 1] != 0)
+        {
+            terms.push_back(Node<ItemType>(dense[power - 1], static_cast<unsigned int>(power - 1)));
+        } // End if
+    } // End for
+    result.assignTerms(terms);
+    return result;
+}  // End interpolateNewton
+
+// Checks the sizes, then interpolates in Newton form
+template <class ItemType>
+SparsePoly<ItemType> PolyInterpolation<ItemType>::interpolate(const std::vector<ItemType>& points, const std::vector<ItemType>& values, char variable)
+{
+    static_assert(std::is_floating_point<ItemType>::value, "Dense interpolation requires a floating point coefficient type");
+    if (points.empty() || points.size() != values.size())
+    {
+        return SparsePoly<ItemType>(variable);
+    } // End if
+    return interpolateNewton(points, values, variable);
+}  // End interpolate
+
+template <class ItemType>
+template <class Function>
+SparsePoly<ItemType> PolyInterpolation<ItemType>::interpolateFunction(Function f, const std::vector<ItemType>& points, unsigned int threadCount, char variable)
+{
+    std::vector<ItemType> values;
+    sampleParallel(f, points, values, threadCount);
+    return interpolate(points, values, variable);
+}  // End interpolateFunction
+
+template <class ItemType>
+template <class BlackBox>
+SparsePoly<ItemType> PolyInterpolation<ItemType>::interpolateSparse(BlackBox blackBox, size_t maxTerms, unsigned int threadCount, char variable)
+{
+    SparsePoly<ItemType> result(variable);
+    if (maxTerms == 0)
+    {
+        return result;
+    } // End if
+
+    // Sample at g^0, g^1, ..., g^(2T - 1); the sample a_i is the sum of c_j (g^e_j)^i
+    std::vector<std::uint64_t> points(2 * maxTerms);
+    points[0] = 1;
+    for (size_t i = 1; i < points.size(); i++)
+    {
+        points[i] = PolyPrimeField::multiply(points[i - 1], PolyPrimeField::GENERATOR);
+    } // End for
+    std::vector<std::uint64_t> samples;
+    sampleParallel(blackBox, points, samples, threadCount);
+    for (std::uint64_t& sample : samples)
+    {
+        sample %= PolyPrimeField::PRIME;
+    } // End for
+
+    const Residues lambda = berlekampMassey(samples);
+    const size_t termCount = lambda.size() - 1;
+    std::vector<std::uint64_t> roots;
+    if (termCount > 0)
+    {
+        findRoots(lambda, roots);
+        if (roots.size() != termCount)
+        {
+            return result;
+        } // End if
+    } // End if
+
+    // Coefficient j is sum(b_i a_i) / Lambda'(r_j), where b are the coefficients of Lambda / (x - r_j)
+    std::vector<std::pair<unsigned int, std::uint64_t>> found;
+    Residues quotient(termCount);
+    for (std::uint64_t root : roots)
+    {
+        quotient[termCount - 1] = lambda[termCount];
+        for (size_t i = termCount - 1; i > 0; i--)
+        {
+            quotient[i - 1] = PolyPrimeField::add(lambda[i], PolyPrimeField::multiply(root, quotient[i]));
+        } // End for
+        std::uint64_t numerator = 0;
+        std::uint64_t denominator = 0;
+        for (size_t i = termCount; i > 0; i--)
+        {
+            numerator = PolyPrimeField::add(numerator, PolyPrimeField::multiply(quotient[i - 1], samples[i - 1]));
+            denominator = PolyPrimeField::add(PolyPrimeField::multiply(denominator, root), quotient[i - 1]);
+        } // End for
+        if (denominator == 0)
+        {
+            return result;
+        } // End if
+        const std::uint64_t coefficient = PolyPrimeField::multiply(numerator, PolyPrimeField::inverse(denominator));
+        found.push_back(std::make_pair(static_cast<unsigned int>(PolyPrimeField::discreteLog(root)), coefficient));
+    } // End for
+
+    // One more sample away from the powers of g tells whether more terms were hiding behind the bound
+    const std::uint64_t checkPoint = 1234567;
+    std::uint64_t expected = 0;
+    for (const std::pair<unsigned int, std::uint64_t>& term : found)
+    {
+        expected = PolyPrimeField::add(expected, PolyPrimeField::multiply(term.second, PolyPrimeField::power(checkPoint, term.first)));
+    } // End for
+    if (blackBox(checkPoint) % PolyPrimeField::PRIME != expected)
+    {
+        return result;
+    } // End if
+
+    std::sort(found.begin(), found.end(), [](const std::pair<unsigned int, std::uint64_t>& a, const std::pair<unsigned int, std::uint64_t>& b)
+    {
+        return a.first > b.first;
+    });
+    std::vector<Node<ItemType>> terms;
+    terms.reserve(found.size());
+    for (const std::pair<unsigned int, std::uint64_t>& term : found)
+    {
+        terms.push_back(Node<ItemType>(static_cast<ItemType>(PolyPrimeField::toInteger(term.second)), term.first));
+    } // End for
+    result.assignTerms(terms);
+    return result;
+}  // End interpolateSparse
+
+template <class ItemType>
+std::uint64_t PolyInterpolation<ItemType>::evaluateModular(const SparsePoly<ItemType>& poly, std::uint64_t x)
+{
+    std::uint64_t sum = 0;
+    poly.forEachTerm([&sum, x](const ItemType& coefficient, unsigned int power)
+    {
+        const std::uint64_t residue = PolyPrimeField::fromInteger(static_cast<long long>(coefficient));
+        sum = PolyPrimeField::add(sum, PolyPrimeField::multiply(residue, PolyPrimeField::power(x, power)));
+    });
+    return sum;
+}  // End evaluateModular
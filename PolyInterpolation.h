@@ -0,0 +1,164 @@
+/** @file PolyInterpolation.h
+* @class PolyInterpolation
+* Reconstructs sparse polynomials from samples. Dense interpolation uses Newton's divided differences over the points in
+* Leja order, at a cost growing as n squared. A subquadratic path through the subproduct tree is not provided: in floating
+* point it loses all accuracy well before the quadratic path becomes too slow.
+*
+* Sparse interpolation (Ben-Or/Tiwari) treats the polynomial as a black box evaluated modulo the prime of PolyPrimeField.
+* Sampling at powers g^i of a primitive root g, Berlekamp-Massey finds the polynomial whose roots are g^e for the powers
+* e of the terms, the roots are found by equal degree splitting, the powers by discrete logarithm and the coefficients by
+* solving a transposed Vandermonde system. Needing 2t samples for t terms, its cost depends on the number of terms and
+* not on the degree. Samples are evaluated on a pool of worker threads in both cases.
+*/
+
+#ifndef POLY_INTERPOLATION_
+#define POLY_INTERPOLATION_
+
+#include "SparsePoly.h"
+#include "Node.h"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+/** Arithmetic modulo the prime used for sparse interpolation. */
+class PolyPrimeField
+{
+public:
+    /** The prime 15 * 2^27 + 1. Products of two residues fit in 64 bits, and p - 1 has only the factors 2, 3 and 5, which
+    * makes discrete logarithms cheap. */
+    static constexpr std::uint64_t PRIME = 2013265921;
+
+    /** A primitive root modulo PRIME. */
+    static constexpr std::uint64_t GENERATOR = 31;
+
+    /** @return a + b modulo PRIME, for reduced a and b. */
+    static std::uint64_t add(std::uint64_t a, std::uint64_t b);
+
+    /** @return a - b modulo PRIME, for reduced a and b. */
+    static std::uint64_t subtract(std::uint64_t a, std::uint64_t b);
+
+    /** @return a * b modulo PRIME, for reduced a and b. */
+    static std::uint64_t multiply(std::uint64_t a, std::uint64_t b);
+
+    /** @return base raised to exponent modulo PRIME. */
+    static std::uint64_t power(std::uint64_t base, std::uint64_t exponent);
+
+    /** @return The multiplicative inverse of a nonzero residue. */
+    static std::uint64_t inverse(std::uint64_t a);
+
+    /** @return The residue of a signed integer. */
+    static std::uint64_t fromInteger(long long value);
+
+    /** @return The integer in (-PRIME / 2, PRIME / 2] with the given residue. */
+    static long long toInteger(std::uint64_t residue);
+
+    /** Finds e with GENERATOR^e = a by Pohlig-Hellman over the factors of PRIME - 1.
+    * @pre a is a nonzero residue.
+    * @return The exponent, below PRIME - 1. */
+    static std::uint64_t discreteLog(std::uint64_t a);
+}; // end PolyPrimeField
+
+template <class ItemType>
+class PolyInterpolation
+{
+private:
+    /** Number of samples a worker claims at once. */
+    static constexpr size_t SAMPLE_CHUNK = 16;
+
+    /** Dense polynomial modulo PolyPrimeField::PRIME, lowest power first. */
+    using Residues = std::vector<std::uint64_t>;
+
+    /** Helper that evaluates a function at every input on a group of worker threads.
+    * @pre f can be called concurrently.
+    * @post outputs[i] holds f(inputs[i]).
+    * @param f The function.
+    * @param inputs The arguments.
+    * @param outputs Receives the results; resized to match inputs.
+    * @param threadCount Number of worker threads, or 0 to use the hardware concurrency. */
+    template <class Function, class Input, class Output>
+    static void sampleParallel(Function& f, const std::vector<Input>& inputs, std::vector<Output>& outputs, unsigned int threadCount);
+
+    /** Helper that interpolates with Newton's divided differences over the points in Leja order, each point the farthest
+    * from those before it, then expands the Newton form by Horner's rule. Quadratic, and accurate to rounding wherever
+    * the monomial coefficients are well conditioned.
+    * @pre points and values are not empty and have the same size.
+    * @post None
+    * @return The interpolating polynomial, or an empty polynomial if two points coincide or a coefficient overflows. */
+    static SparsePoly<ItemType> interpolateNewton(const std::vector<ItemType>& points, const std::vector<ItemType>& values, char variable);
+
+    /** Helper for the modular path that multiplies two dense polynomials. */
+    static Residues multiplyResidues(const Residues& a, const Residues& b);
+
+    /** Helper for the modular path that replaces a dense polynomial by its remainder modulo another.
+    * @pre divisor has a nonzero leading coefficient. */
+    static void reduceResidues(Residues& dividend, const Residues& divisor);
+
+    /** Helper for the modular path that divides exactly by a polynomial known to be a factor. */
+    static Residues divideResidues(Residues dividend, const Residues& divisor);
+
+    /** Helper for the modular path that computes a monic greatest common divisor. */
+    static Residues gcdResidues(Residues a, Residues b);
+
+    /** Helper that finds the smallest linear recurrence generating a sequence (Berlekamp-Massey).
+    * @pre None
+    * @post None
+    * @param sequence Residues a_0, a_1, ...
+    * @return The connection polynomial reversed into a monic polynomial Lambda, whose roots are the terms' g^e. */
+    static Residues berlekampMassey(const std::vector<std::uint64_t>& sequence);
+
+    /** Helper that finds the roots of a polynomial that splits into distinct linear factors, by equal degree splitting.
+    * @pre None
+    * @post None
+    * @param poly Dense polynomial of degree at least 1.
+    * @param roots Receives the roots. Fewer roots than the degree are found if the polynomial does not split. */
+    static void findRoots(const Residues& poly, std::vector<std::uint64_t>& roots);
+
+public:
+    /** Finds the polynomial of degree below n through n points with Newton's divided differences, in O(n^2).
+    * @pre ItemType is a floating point type. The monomial coefficients of an interpolant grow quickly ill conditioned: in
+    * double precision the result stays accurate to rounding up to about 50 Chebyshev points in [-1, 1], and loses all
+    * accuracy near 100.
+    * @post None
+    * @param points The distinct values of the variable.
+    * @param values The value of the polynomial at each point.
+    * @param variable The variable of the result.
+    * @return The interpolating polynomial, or an empty polynomial if the sizes differ, no points are given, two points
+    * coincide or a coefficient overflows. */
+    static SparsePoly<ItemType> interpolate(const std::vector<ItemType>& points, const std::vector<ItemType>& values, char variable = 'x');
+
+    /** Samples a function at n points in parallel and interpolates the samples as interpolate does.
+    * @pre f(ItemType) can be called concurrently from several threads.
+    * @post None
+    * @param f The function.
+    * @param points The distinct values of the variable.
+    * @param threadCount Number of worker threads, or 0 to use the hardware concurrency.
+    * @param variable The variable of the result.
+    * @return The interpolating polynomial, or an empty polynomial if the points are empty, two coincide or a coefficient overflows. */
+    template <class Function>
+    static SparsePoly<ItemType> interpolateFunction(Function f, const std::vector<ItemType>& points, unsigned int threadCount = 0, char variable = 'x');
+
+    /** Reconstructs a sparse polynomial with integer coefficients from a black box, with Ben-Or/Tiwari interpolation modulo
+    * PolyPrimeField::PRIME. Takes 2 * maxTerms samples, evaluated in parallel, and one more to check the result.
+    * @pre blackBox(x) returns the polynomial at the residue x modulo PolyPrimeField::PRIME and can be called concurrently.
+    * The polynomial has at most maxTerms terms, coefficients of magnitude below PRIME / 2 and powers below PRIME - 1.
+    * @post None
+    * @param blackBox The function to interpolate.
+    * @param maxTerms Bound on the number of terms.
+    * @param threadCount Number of worker threads, or 0 to use the hardware concurrency.
+    * @param variable The variable of the result.
+    * @return The polynomial, or an empty polynomial if no polynomial with at most maxTerms terms matches the black box. */
+    template <class BlackBox>
+    static SparsePoly<ItemType> interpolateSparse(BlackBox blackBox, size_t maxTerms, unsigned int threadCount = 0, char variable = 'x');
+
+    /** Evaluates a polynomial with integer coefficients modulo PolyPrimeField::PRIME, for use as a black box.
+    * @pre The coefficients are integers.
+    * @post Does not change the polynomial.
+    * @param poly The polynomial.
+    * @param x A residue modulo PRIME.
+    * @return The value of the polynomial at x modulo PRIME. */
+    static std::uint64_t evaluateModular(const SparsePoly<ItemType>& poly, std::uint64_t x);
+}; // end PolyInterpolation
+
+#include "PolyInterpolation.cpp"
+#endif
@@ -0,0 +1,451 @@
+/** @file PolyJobScheduler.cpp
+* Job graph executor for polynomial operations. This file is included by its header, so the non-template functions
+* are inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyJobScheduler.h"
+#include <algorithm>
+#include <exception>
+#include <utility>
+
+inline PolyJobState::PolyJobState() : done(false)
+{ }  // End constructor
+
+inline bool PolyJobState::addContinuation(std::function<void()> continuation)
+{
+    std::lock_guard<std::mutex> guard(lock);
+    if (done)
+    {
+        return false;
+    } // End if
+    continuations.push_back(std::move(continuation));
+    return true;
+}  // End addContinuation
+
+// Continuations run outside the lock so they can register more work
+inline void PolyJobState::complete()
+{
+    std::vector<std::function<void()>> waiting;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        done = true;
+        waiting.swap(continuations);
+    }
+    for (std::function<void()>& continuation : waiting)
+    {
+        continuation();
+    } // End for
+}  // End complete
+
+inline bool PolyJobState::isDone()
+{
+    std::lock_guard<std::mutex> guard(lock);
+    return done;
+}  // End isDone
+
+template <class Result>
+PolyJob<Result>::PolyJob(std::shared_future<Result> someFuture, std::shared_ptr<PolyJobState> someState)
+    : future(std::move(someFuture)), state(std::move(someState))
+{ }  // End constructor
+
+template <class Result>
+const Result& PolyJob<Result>::get() const
+{
+    return future.get();
+}  // End get
+
+template <class Result>
+void PolyJob<Result>::wait() const
+{
+    future.wait();
+}  // End wait
+
+template <class Result>
+bool PolyJob<Result>::isReady() const
+{
+    return state->isDone();
+}  // End isReady
+
+#ifdef POLY_JOB_COROUTINES
+template <class Result>
+bool PolyJob<Result>::Awaiter::await_ready() const
+{
+    return job->isReady();
+}  // End await_ready
+
+// Resumes the coroutine from the job's completion; if the job finished in the meantime, do not suspend at all
+template <class Result>
+bool PolyJob<Result>::Awaiter::await_suspend(std::coroutine_handle<> handle) const
+{
+    return job->state->addContinuation([handle]() { handle.resume(); });
+}  // End await_suspend
+
+template <class Result>
+Result PolyJob<Result>::Awaiter::await_resume() const
+{
+    return job->get();
+}  // End await_resume
+
+template <class Result>
+typename PolyJob<Result>::Awaiter PolyJob<Result>::operator co_await() const
+{
+    return Awaiter{ this };
+}  // End operator co_await
+
+template <class Result>
+PolyTask<Result> PolyTask<Result>::promise_type::get_return_object()
+{
+    return PolyTask(Handle::from_promise(*this));
+}  // End get_return_object
+
+template <class Result>
+std::suspend_always PolyTask<Result>::promise_type::initial_suspend() noexcept
+{
+    return {};
+}  // End initial_suspend
+
+template <class Result>
+typename PolyTask<Result>::promise_type::FinalAwaiter PolyTask<Result>::promise_type::final_suspend() noexcept
+{
+    return {};
+}  // End final_suspend
+
+template <class Result>
+bool PolyTask<Result>::promise_type::FinalAwaiter::await_ready() const noexcept
+{
+    return false;
+}  // End await_ready
+
+template <class Result>
+void PolyTask<Result>::promise_type::FinalAwaiter::await_suspend(Handle handle) const noexcept
+{
+    PolyJobScheduler* scheduler = handle.promise().scheduler;
+    std::shared_ptr<PolyJobState> state = std::move(handle.promise().state);
+    handle.destroy();
+    scheduler->finishJob(state);
+}  // End await_suspend
+
+template <class Result>
+void PolyTask<Result>::promise_type::FinalAwaiter::await_resume() const noexcept
+{ }  // End await_resume
+
+template <class Result>
+void PolyTask<Result>::promise_type::return_value(Result value)
+{
+    result.set_value(std::move(value));
+}  // End return_value
+
+template <class Result>
+void PolyTask<Result>::promise_type::unhandled_exception()
+{
+    result.set_exception(std::current_exception());
+}  // End unhandled_exception
+
+template <class Result>
+PolyTask<Result>::PolyTask(Handle someHandle) : handle(someHandle)
+{ }  // End constructor
+
+template <class Result>
+PolyTask<Result>::PolyTask(PolyTask&& other) noexcept : handle(other.handle)
+{
+    other.handle = nullptr;
+}  // End move constructor
+
+template <class Result>
+PolyTask<Result>::~PolyTask()
+{
+    if (handle)
+    {
+        handle.destroy();
+    } // End if
+}  // End destructor
+#endif
+
+inline bool& PolyJobScheduler::isWorkerThread()
+{
+    static thread_local bool worker = false;
+    return worker;
+}  // End isWorkerThread
+
+// Constructor starts the pool
+inline PolyJobScheduler::PolyJobScheduler(unsigned int threadCount, size_t maxOutstanding)
+    : outstanding(0), capacity(std::max<size_t>(1, maxOutstanding)), stopping(false)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    } // End if
+    for (unsigned int t = 0; t < threadCount; t++)
+    {
+        workers.push_back(std::thread([this]() { workerLoop(); }));
+    } // End for
+}  // End constructor
+
+// Workers take a share of the ready queue at a time so a burst of small jobs costs few lock acquisitions
+inline void PolyJobScheduler::workerLoop()
+{
+    isWorkerThread() = true;
+    std::vector<std::function<void()>> batch;
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> guard(queueLock);
+            readyCondition.wait(guard, [this]() { return stopping || !readyQueue.empty(); });
+            if (readyQueue.empty())
+            {
+                return; // Stopping with nothing left to run
+            } // End if
+            const size_t share = std::min(DEQUEUE_BATCH, readyQueue.size() / workers.size() + 1);
+            while (batch.size() < share)
+            {
+                batch.push_back(std::move(readyQueue.front()));
+                readyQueue.pop_front();
+            } // End while
+        }
+        for (std::function<void()>& work : batch)
+        {
+            work();
+        } // End for
+        batch.clear();
+    } // End while
+}  // End workerLoop
+
+inline void PolyJobScheduler::admit()
+{
+    std::unique_lock<std::mutex> guard(queueLock);
+    if (!isWorkerThread())
+    {
+        // Jobs submitted from inside the pool never wait, or a full pool could wait on itself
+        spaceCondition.wait(guard, [this]() { return outstanding < capacity; });
+    } // End if
+    outstanding++;
+}  // End admit
+
+inline void PolyJobScheduler::enqueue(std::function<void()> work)
+{
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        readyQueue.push_back(std::move(work));
+    }
+    readyCondition.notify_one();
+}  // End enqueue
+
+// Every dependency counts down a shared counter; the extra count held here stops the work from starting before all are registered
+inline void PolyJobScheduler::runAfter(const std::vector<std::shared_ptr<PolyJobState>>& dependencies, std::function<void()> work)
+{
+    std::shared_ptr<std::atomic<size_t>> remaining = std::make_shared<std::atomic<size_t>>(dependencies.size() + 1);
+    std::shared_ptr<std::function<void()>> shared = std::make_shared<std::function<void()>>(std::move(work));
+    auto countDown = [this, remaining, shared]()
+    {
+        if (remaining->fetch_sub(1) == 1)
+        {
+            enqueue(std::move(*shared));
+        } // End if
+    };
+    for (const std::shared_ptr<PolyJobState>& dependency : dependencies)
+    {
+        if (!dependency->addContinuation(countDown))
+        {
+            countDown();
+        } // End if
+    } // End for
+    countDown();
+}  // End runAfter
+
+inline void PolyJobScheduler::finishJob(const std::shared_ptr<PolyJobState>& state)
+{
+    state->complete();
+    // Notify under the lock so waitIdle, and with it the destructor, cannot finish while this call still uses the scheduler
+    std::lock_guard<std::mutex> guard(queueLock);
+    outstanding--;
+    spaceCondition.notify_all();
+}  // End finishJob
+
+template <class Result, class Fn, class... Dependencies>
+void PolyJobScheduler::storeResult(std::promise<Result>& promise, Fn& fn, const PolyJob<Dependencies>&... dependencies)
+{
+    try
+    {
+        promise.set_value(fn(dependencies.get()...));
+    }
+    catch (...)
+    {
+        promise.set_exception(std::current_exception());
+    } // End try
+}  // End storeResult
+
+template <class Result>
+PolyJob<Result> PolyJobScheduler::ready(Result value)
+{
+    std::promise<Result> promise;
+    promise.set_value(std::move(value));
+    std::shared_ptr<PolyJobState> state = std::make_shared<PolyJobState>();
+    state->complete();
+    return PolyJob<Result>(promise.get_future().share(), state);
+}  // End ready
+
+template <class Fn, class... Dependencies>
+auto PolyJobScheduler::submit(Fn fn, const PolyJob<Dependencies>&... dependencies)
+    -> PolyJob<typename std::decay<decltype(fn(std::declval<const Dependencies&>()...))>::type>
+{
+    using Result = typename std::decay<decltype(fn(std::declval<const Dependencies&>()...))>::type;
+    static_assert(!std::is_void<Result>::value, "A job must return a value");
+
+    std::shared_ptr<std::promise<Result>> promise = std::make_shared<std::promise<Result>>();
+    std::shared_ptr<PolyJobState> state = std::make_shared<PolyJobState>();
+    PolyJob<Result> job(promise->get_future().share(), state);
+
+    admit();
+    runAfter({ dependencies.state... }, [this, fn, promise, state, dependencies...]() mutable
+    {
+        storeResult(*promise, fn, dependencies...);
+        finishJob(state);
+    });
+    return job;
+}  // End submit
+
+template <class ItemType>
+PolyJob<SparsePoly<ItemType>> PolyJobScheduler::add(const PolyJob<SparsePoly<ItemType>>& a, const PolyJob<SparsePoly<ItemType>>& b)
+{
+    return submit([](const SparsePoly<ItemType>& left, const SparsePoly<ItemType>& right) { return left.add(right); }, a, b);
+}  // End add
+
+template <class ItemType>
+PolyJob<SparsePoly<ItemType>> PolyJobScheduler::multiply(const PolyJob<SparsePoly<ItemType>>& a, const PolyJob<SparsePoly<ItemType>>& b)
+{
+    return submit([](const SparsePoly<ItemType>& left, const SparsePoly<ItemType>& right) { return left.multiply(right); }, a, b);
+}  // End multiply
+
+template <class ItemType>
+PolyJob<std::string> PolyJobScheduler::display(const PolyJob<SparsePoly<ItemType>>& poly)
+{
+    return submit([](const SparsePoly<ItemType>& somePoly) { return somePoly.displayPoly(); }, poly);
+}  // End display
+
+// Joins the open batch for this polynomial, or opens one and schedules it behind the polynomial job
+template <class ItemType>
+PolyJob<ItemType> PolyJobScheduler::evaluate(const PolyJob<SparsePoly<ItemType>>& poly, ItemType x)
+{
+    std::shared_ptr<std::promise<ItemType>> promise = std::make_shared<std::promise<ItemType>>();
+    std::shared_ptr<PolyJobState> state = std::make_shared<PolyJobState>();
+    PolyJob<ItemType> job(promise->get_future().share(), state);
+    admit();
+
+    const PolyJobState* key = poly.state.get();
+    std::shared_ptr<EvaluationBatch<ItemType>> batch;
+    {
+        std::lock_guard<std::mutex> guard(fusionLock);
+        auto found = openEvaluations.find(key);
+        if (found != openEvaluations.end())
+        {
+            batch = std::static_pointer_cast<EvaluationBatch<ItemType>>(found->second);
+            batch->points.push_back(x);
+            batch->promises.push_back(promise);
+            batch->states.push_back(state);
+            return job;
+        } // End if
+        batch = std::make_shared<EvaluationBatch<ItemType>>();
+        batch->points.push_back(x);
+        batch->promises.push_back(promise);
+        batch->states.push_back(state);
+        openEvaluations[key] = batch;
+    }
+
+    // The batch keeps the polynomial job, and with it the key, alive until the batch closes
+    runAfter({ poly.state }, [this, batch, poly, key]()
+    {
+        {
+            std::lock_guard<std::mutex> guard(fusionLock);
+            auto found = openEvaluations.find(key);
+            if (found != openEvaluations.end() && found->second == batch)
+            {
+                openEvaluations.erase(found); // Later evaluations open a new batch
+            } // End if
+        }
+
+        try
+        {
+            // Collect the terms once, then run Horner's rule over the power gaps for every point
+            std::vector<Node<ItemType>> terms;
+            poly.get().forEachTerm([&terms](const ItemType& coefficient, unsigned int power)
+            {
+                terms.push_back(Node<ItemType>(coefficient, power));
+            });
+            for (size_t i = 0; i < batch->points.size(); i++)
+            {
+                const ItemType point = batch->points[i];
+                ItemType value = 0;
+                for (size_t t = 0; t < terms.size(); t++)
+                {
+                    value = (t == 0) ? terms[0].getCoefficient()
+                        : value * PolyKernels<ItemType>::power(point, terms[t - 1].getPower() - terms[t].getPower()) + terms[t].getCoefficient();
+                } // End for
+                if (!terms.empty())
+                {
+                    value *= PolyKernels<ItemType>::power(point, terms.back().getPower());
+                } // End if
+                batch->promises[i]->set_value(value);
+            } // End for
+        }
+        catch (...)
+        {
+            for (const std::shared_ptr<std::promise<ItemType>>& waiting : batch->promises)
+            {
+                try
+                {
+                    waiting->set_exception(std::current_exception());
+                }
+                catch (const std::future_error&)
+                {
+                    // Already holds a value
+                } // End try
+            } // End for
+        } // End try
+        for (const std::shared_ptr<PolyJobState>& finished : batch->states)
+        {
+            finishJob(finished);
+        } // End for
+    });
+    return job;
+}  // End evaluate
+
+#ifdef POLY_JOB_COROUTINES
+template <class Result>
+PolyJob<Result> PolyJobScheduler::spawn(PolyTask<Result> task)
+{
+    typename PolyTask<Result>::Handle handle = task.handle;
+    task.handle = nullptr; // The frame now destroys itself when the coroutine finishes
+
+    std::shared_ptr<PolyJobState> state = std::make_shared<PolyJobState>();
+    handle.promise().state = state;
+    handle.promise().scheduler = this;
+    PolyJob<Result> job(handle.promise().result.get_future().share(), state);
+
+    admit();
+    enqueue([handle]() { handle.resume(); });
+    return job;
+}  // End spawn
+#endif
+
+inline void PolyJobScheduler::waitIdle()
+{
+    std::unique_lock<std::mutex> guard(queueLock);
+    spaceCondition.wait(guard, [this]() { return outstanding == 0; });
+}  // End waitIdle
+
+inline PolyJobScheduler::~PolyJobScheduler()
+{
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> guard(queueLock);
+        stopping = true;
+    }
+    readyCondition.notify_all();
+    for (std::thread& worker : workers)
+    {
+        worker.join();
+    } // End for
+}  // End destructor
@@ -0,0 +1,300 @@
+/** @file PolyJobScheduler.h
+* @class PolyJobScheduler
+* Runs graphs of polynomial operations on a bounded pool of worker threads. Each submitted operation is a job that
+* starts once the jobs it depends on have finished and hands its result to later jobs and to the caller through a
+* PolyJob, which wraps a shared future. Evaluations of the same polynomial job that are still waiting to run are fused
+* into one job that walks the terms once for all of the points. The number of unfinished jobs is capped: once the cap
+* is reached, submitting from outside the pool blocks until jobs finish.
+*
+* When the compiler supports C++20 coroutines, a coroutine returning PolyTask can be spawned as a job and can co_await
+* other jobs without blocking a worker thread.
+*/
+
+#ifndef POLY_JOB_SCHEDULER_
+#define POLY_JOB_SCHEDULER_
+
+#include "SparsePoly.h"
+#include "Node.h"
+#include "PolyKernels.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define POLY_JOB_COROUTINES 1
+#endif
+#endif
+
+class PolyJobScheduler;
+
+/** Completion flag of one job and the work waiting on it. */
+class PolyJobState
+{
+private:
+    std::mutex lock;
+    bool done;
+    std::vector<std::function<void()>> continuations;
+
+public:
+    /** Constructor
+    * @pre None
+    * @post The job is not done. */
+    PolyJobState();
+
+    /** Registers work to run when the job finishes.
+    * @pre None
+    * @post The continuation runs exactly once, on the thread that finishes the job, unless the job is already done.
+    * @param continuation The work to run.
+    * @return False if the job was already done; the continuation is not stored and the caller should run it. */
+    bool addContinuation(std::function<void()> continuation);
+
+    /** Marks the job done and runs every stored continuation.
+    * @pre The job's result has been stored.
+    * @post None */
+    void complete();
+
+    /** @return True once complete has been called. */
+    bool isDone();
+}; // end PolyJobState
+
+/** Handle to the result of a job. Copies refer to the same job. */
+template <class Result>
+class PolyJob
+{
+private:
+    std::shared_future<Result> future;
+    std::shared_ptr<PolyJobState> state;
+
+    friend class PolyJobScheduler;
+
+public:
+    using value_type = Result;
+
+    /** Constructor used by the scheduler.
+    * @param someFuture The future the job's result is stored in.
+    * @param someState The job's completion state. */
+    PolyJob(std::shared_future<Result> someFuture, std::shared_ptr<PolyJobState> someState);
+
+    /** Waits for the job and returns its result.
+    * @pre Must not be called from a job that the awaited job depends on.
+    * @post None
+    * @return The result. Rethrows the exception if the job, or a job it depends on, threw. */
+    const Result& get() const;
+
+    /** Waits for the job to finish.
+    * @pre None
+    * @post The job is done. */
+    void wait() const;
+
+    /** @return True if the job has finished. */
+    bool isReady() const;
+
+#ifdef POLY_JOB_COROUTINES
+    /** Suspends a coroutine until the job finishes. The coroutine resumes on the thread that finishes the job. */
+    struct Awaiter
+    {
+        const PolyJob* job;
+
+        bool await_ready() const;
+        bool await_suspend(std::coroutine_handle<> handle) const;
+        Result await_resume() const;
+    };
+
+    /** @return An awaiter so a PolyTask coroutine can write co_await job. */
+    Awaiter operator co_await() const;
+#endif
+}; // end PolyJob
+
+#ifdef POLY_JOB_COROUTINES
+/** Coroutine type for jobs. A PolyTask does nothing until it is passed to PolyJobScheduler::spawn. */
+template <class Result>
+class PolyTask
+{
+public:
+    struct promise_type;
+    using Handle = std::coroutine_handle<promise_type>;
+
+    struct promise_type
+    {
+        std::promise<Result> result;
+        std::shared_ptr<PolyJobState> state;
+        PolyJobScheduler* scheduler = nullptr;
+
+        PolyTask get_return_object();
+        std::suspend_always initial_suspend() noexcept;
+
+        /** Destroys the frame, then finishes the job so nothing waiting on it outlives the coroutine's locals. */
+        struct FinalAwaiter
+        {
+            bool await_ready() const noexcept;
+            void await_suspend(Handle handle) const noexcept;
+            void await_resume() const noexcept;
+        };
+        FinalAwaiter final_suspend() noexcept;
+
+        void return_value(Result value);
+        void unhandled_exception();
+    };
+
+    PolyTask(PolyTask&& other) noexcept;
+    PolyTask(const PolyTask&) = delete;
+    PolyTask& operator=(const PolyTask&) = delete;
+    PolyTask& operator=(PolyTask&&) = delete;
+
+    /** Destroys the coroutine if it was never spawned. */
+    ~PolyTask();
+
+private:
+    explicit PolyTask(Handle someHandle);
+
+    Handle handle;
+
+    friend class PolyJobScheduler;
+}; // end PolyTask
+#endif
+
+class PolyJobScheduler
+{
+private:
+    /** Maximum number of ready jobs a worker takes from the queue at once. */
+    static constexpr size_t DEQUEUE_BATCH = 16;
+
+    /** Evaluations of one polynomial job that have not started yet. */
+    template <class ItemType>
+    struct EvaluationBatch
+    {
+        std::vector<ItemType> points;
+        std::vector<std::shared_ptr<std::promise<ItemType>>> promises;
+        std::vector<std::shared_ptr<PolyJobState>> states;
+    };
+
+    std::vector<std::thread> workers;
+
+    /** Guards the ready queue and the job counts. */
+    std::mutex queueLock;
+    std::condition_variable readyCondition; // Signalled when work is queued or the pool stops
+    std::condition_variable spaceCondition; // Signalled when a job finishes
+    std::deque<std::function<void()>> readyQueue;
+    size_t outstanding; // Jobs submitted and not yet finished
+    size_t capacity;
+    bool stopping;
+
+    /** Guards openEvaluations. */
+    std::mutex fusionLock;
+
+    /** Evaluation batches that can still take more points, keyed by the state of the polynomial job. */
+    std::map<const PolyJobState*, std::shared_ptr<void>> openEvaluations;
+
+    /** @return True on the scheduler's worker threads, which never block on the job cap. */
+    static bool& isWorkerThread();
+
+    /** Body of every worker thread. */
+    void workerLoop();
+
+    /** Counts a new job, blocking callers outside the pool while the cap is reached. */
+    void admit();
+
+    /** Queues work that is ready to run. */
+    void enqueue(std::function<void()> work);
+
+    /** Queues work once every dependency has finished. */
+    void runAfter(const std::vector<std::shared_ptr<PolyJobState>>& dependencies, std::function<void()> work);
+
+    /** Completes a job's state and releases its place under the cap. */
+    void finishJob(const std::shared_ptr<PolyJobState>& state);
+
+    /** Helper for submit that stores the result of fn, or the exception it throws, into a promise. */
+    template <class Result, class Fn, class... Dependencies>
+    static void storeResult(std::promise<Result>& promise, Fn& fn, const PolyJob<Dependencies>&... dependencies);
+
+#ifdef POLY_JOB_COROUTINES
+    template <class Result>
+    friend class PolyTask;
+#endif
+
+public:
+    /** Constructor that starts the worker threads.
+    * @pre None
+    * @post The pool is running.
+    * @param threadCount Number of worker threads, 0 uses the number of hardware threads.
+    * @param maxOutstanding Number of unfinished jobs at which submitting from outside the pool blocks. */
+    explicit PolyJobScheduler(unsigned int threadCount = 0, size_t maxOutstanding = 1024);
+
+    PolyJobScheduler(const PolyJobScheduler&) = delete;
+    PolyJobScheduler& operator=(const PolyJobScheduler&) = delete;
+
+    /** Makes a job that is already finished, for feeding existing values into a graph.
+    * @pre None
+    * @post None
+    * @param value The result of the job.
+    * @return The finished job. */
+    template <class Result>
+    PolyJob<Result> ready(Result value);
+
+    /** Submits a job that calls fn with the results of its dependencies once they have all finished.
+    * @pre fn returns a value (not void) and can be called as fn(dependency results...).
+    * @post The job is queued; the caller may block if the cap on unfinished jobs is reached.
+    * @param fn The operation.
+    * @param dependencies Jobs whose results are passed to fn, in order.
+    * @return The job. If fn or a dependency throws, get rethrows the exception. */
+    template <class Fn, class... Dependencies>
+    auto submit(Fn fn, const PolyJob<Dependencies>&... dependencies)
+        -> PolyJob<typename std::decay<decltype(fn(std::declval<const Dependencies&>()...))>::type>;
+
+    /** Submits the sum of two polynomial jobs. */
+    template <class ItemType>
+    PolyJob<SparsePoly<ItemType>> add(const PolyJob<SparsePoly<ItemType>>& a, const PolyJob<SparsePoly<ItemType>>& b);
+
+    /** Submits the product of two polynomial jobs. */
+    template <class ItemType>
+    PolyJob<SparsePoly<ItemType>> multiply(const PolyJob<SparsePoly<ItemType>>& a, const PolyJob<SparsePoly<ItemType>>& b);
+
+    /** Submits the display string of a polynomial job. */
+    template <class ItemType>
+    PolyJob<std::string> display(const PolyJob<SparsePoly<ItemType>>& poly);
+
+    /** Submits the evaluation of a polynomial job at a point. Evaluations of the same polynomial job that have not started
+    * yet join one batch that collects the terms once and runs Horner's rule for every point.
+    * @pre None
+    * @post The evaluation is queued.
+    * @param poly The polynomial job.
+    * @param x The point.
+    * @return The job holding the value of the polynomial at x. */
+    template <class ItemType>
+    PolyJob<ItemType> evaluate(const PolyJob<SparsePoly<ItemType>>& poly, ItemType x);
+
+#ifdef POLY_JOB_COROUTINES
+    /** Starts a coroutine on the pool. The job finishes when the coroutine returns.
+    * @pre The task has not been spawned before.
+    * @post The coroutine is queued to run.
+    * @param task The coroutine.
+    * @return The job holding the coroutine's result. */
+    template <class Result>
+    PolyJob<Result> spawn(PolyTask<Result> task);
+#endif
+
+    /** Waits until every submitted job has finished.
+    * @pre Must not be called from a job.
+    * @post No job is unfinished. */
+    void waitIdle();
+
+    /** Destructor that waits for every job, then stops the workers.
+    * @pre Must not be called from a job.
+    * @post None */
+    ~PolyJobScheduler();
+}; // end PolyJobScheduler
+
+#include "PolyJobScheduler.cpp"
+#endif
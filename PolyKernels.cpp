@@ -0,0 +1,352 @@
+/** @file PolyKernels.cpp
+* Dense coefficient kernels shared by the SparsePoly operations that work on contiguous runs of powers.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyKernels.h"
+#include <algorithm>
+
+// Raises a value to a power by repeated squaring
+template <class ItemType>
+ItemType PolyKernels<ItemType>::power(ItemType base, unsigned int exponent)
+{
+    ItemType result = static_cast<ItemType>(1);
+    while (exponent > 0)
+    {
+        if (exponent & 1u)
+        {
+            result *= base;
+        } // End if
+        exponent >>= 1;
+        if (exponent > 0)
+        {
+            base *= base;
+        } // End if
+    } // End while
+    return result;
+}  // End power
+
+template <class ItemType>
+size_t PolyKernels<ItemType>::karatsubaThreshold()
+{
+    static const size_t threshold = PolySimd::vectorizes<ItemType>() ? VECTOR_KARATSUBA_THRESHOLD : KARATSUBA_THRESHOLD;
+    return threshold;
+}  // End karatsubaThreshold
+
+// Schoolbook multiply-accumulate of two coefficient runs, tiled over both operands
+template <class ItemType>
+void PolyKernels<ItemType>::multiplyAccumulate(const ItemType* a, size_t n, const ItemType* b, size_t m, ItemType* out)
+{
+    if (m < VECTOR_ROW_THRESHOLD)
+    {
+        for (size_t i = 0; i < n; i++)
+        {
+            const ItemType ai = a[i];
+            if (ai == 0)
+            {
+                continue;
+            } // End if
+            ItemType* row = out + i;
+            for (size_t j = 0; j < m; j++)
+            {
+                row[j] += ai * b[j];
+            } // End for
+        } // End for
+        return;
+    } // End if
+
+    // Within a tile of b, consecutive rows update output windows that overlap in all but one place, so the tile and
+    // the window stay in L1 while the block of a streams past; the block of a is reused from L2 by every tile
+    const size_t tile = std::max<size_t>(VECTOR_ROW_THRESHOLD, L1_TILE_BYTES / sizeof(ItemType));
+    const size_t block = std::max<size_t>(1, L2_BLOCK_BYTES / sizeof(ItemType));
+    for (size_t blockStart = 0; blockStart < n; blockStart += block)
+    {
+        const size_t blockEnd = std::min(n, blockStart + block);
+        for (size_t tileStart = 0; tileStart < m; tileStart += tile)
+        {
+            const size_t length = std::min(tile, m - tileStart);
+            for (size_t i = blockStart; i < blockEnd; i++)
+            {
+                if (a[i] != 0)
+                {
+                    PolySimd::multiplyAddRow(out + i + tileStart, b + tileStart, a[i], length);
+                } // End if
+            } // End for
+        } // End for
+    } // End for
+}  // End multiplyAccumulate
+
+// Karatsuba multiplication of two equal length operands
+template <class ItemType>
+void PolyKernels<ItemType>::karatsuba(const ItemType* a, const ItemType* b, size_t n, ItemType* out)
+{
+    if (n < karatsubaThreshold())
+    {
+        multiplyAccumulate(a, n, b, n, out);
+        return;
+    } // End if
+
+    const size_t half = n / 2;       // Length of the low halves
+    const size_t highLength = n - half; // Length of the high halves, never shorter than the low halves
+
+    // z0 = a0 * b0 goes straight into the low part of the output, z2 = a1 * b1 into the high part
+    std::vector<ItemType> z0(2 * half - 1, static_cast<ItemType>(0));
+    std::vector<ItemType> z2(2 * highLength - 1, static_cast<ItemType>(0));
+    karatsuba(a, b, half, z0.data());
+    karatsuba(a + half, b + half, highLength, z2.data());
+
+    // z1 = (a0 + a1) * (b0 + b1) - z0 - z2
+    std::vector<ItemType> aSum(a + half, a + n);
+    std::vector<ItemType> bSum(b + half, b + n);
+    for (size_t i = 0; i < half; i++)
+    {
+        aSum[i] += a[i];
+        bSum[i] += b[i];
+    } // End for
+    std::vector<ItemType> z1(2 * highLength - 1, static_cast<ItemType>(0));
+    karatsuba(aSum.data(), bSum.data(), highLength, z1.data());
+    for (size_t i = 0; i < z0.size(); i++)
+    {
+        z1[i] -= z0[i];
+    } // End for
+    for (size_t i = 0; i < z2.size(); i++)
+    {
+        z1[i] -= z2[i];
+    } // End for
+
+    for (size_t i = 0; i < z0.size(); i++)
+    {
+        out[i] += z0[i];
+    } // End for
+    for (size_t i = 0; i < z1.size(); i++)
+    {
+        out[i + half] += z1[i];
+    } // End for
+    for (size_t i = 0; i < z2.size(); i++)
+    {
+        out[i + 2 * half] += z2[i];
+    } // End for
+}  // End karatsuba
+
+// Multiplies two dense polynomials into a reusable output buffer
+template <class ItemType>
+void PolyKernels<ItemType>::multiplyInto(const std::vector<ItemType>& a, const std::vector<ItemType>& b, std::vector<ItemType>& out)
+{
+    out.clear();
+    if (a.empty() || b.empty())
+    {
+        return;
+    } // End if
+    out.assign(a.size() + b.size() - 1, static_cast<ItemType>(0));
+
+    const std::vector<ItemType>& shorter = (a.size() <= b.size()) ? a : b;
+    const std::vector<ItemType>& longer = (a.size() <= b.size()) ? b : a;
+    const size_t n = shorter.size();
+
+    if (n < karatsubaThreshold())
+    {
+        multiplyAccumulate(shorter.data(), n, longer.data(), longer.size(), out.data());
+        return;
+    } // End if
+
+    // Split the longer operand into chunks the length of the shorter one and multiply each chunk with Karatsuba
+    std::vector<ItemType> chunk(n);
+    std::vector<ItemType> partial(2 * n - 1);
+    for (size_t offset = 0; offset < longer.size(); offset += n)
+    {
+        const size_t length = std::min(n, longer.size() - offset);
+        std::fill(chunk.begin(), chunk.end(), static_cast<ItemType>(0));
+        std::copy(longer.begin() + offset, longer.begin() + offset + length, chunk.begin());
+        std::fill(partial.begin(), partial.end(), static_cast<ItemType>(0));
+        karatsuba(shorter.data(), chunk.data(), n, partial.data());
+
+        // The padded tail of the last chunk contributes only zeros past the end of the product
+        const size_t limit = std::min(partial.size(), out.size() - offset);
+        for (size_t i = 0; i < limit; i++)
+        {
+            out[offset + i] += partial[i];
+        } // End for
+    } // End for
+}  // End multiplyInto
+
+// Multiplies two dense polynomials
+template <class ItemType>
+std::vector<ItemType> PolyKernels<ItemType>::multiply(const std::vector<ItemType>& a, const std::vector<ItemType>& b)
+{
+    std::vector<ItemType> out;
+    multiplyInto(a, b, out);
+    return out;
+}  // End multiply
+
+// Short product: low halves in full, cross terms recursively, high halves never
+template <class ItemType>
+void PolyKernels<ItemType>::shortProduct(const ItemType* a, const ItemType* b, size_t limit, ItemType* out)
+{
+    if (limit < karatsubaThreshold())
+    {
+        for (size_t i = 0; i < limit; i++)
+        {
+            const ItemType ai = a[i];
+            if (ai == 0)
+            {
+                continue;
+            } // End if
+            PolySimd::multiplyAddRow(out + i, b, ai, limit - i);
+        } // End for
+        return;
+    } // End if
+
+    // With half = ceil(limit / 2), a0 * b0 fills at most limit coefficients and a1 * b1 starts at or above limit
+    const size_t half = (limit + 1) / 2;
+    karatsuba(a, b, half, out);
+    shortProduct(a + half, b, limit - half, out + half);
+    shortProduct(a, b + half, limit - half, out + half);
+}  // End shortProduct
+
+// Multiplies two dense polynomials up to a limit
+template <class ItemType>
+void PolyKernels<ItemType>::multiplyTruncatedInto(const std::vector<ItemType>& a, const std::vector<ItemType>& b, size_t limit, std::vector<ItemType>& out)
+{
+    out.clear();
+    const size_t n = std::min(a.size(), limit);
+    const size_t m = std::min(b.size(), limit);
+    if (n == 0 || m == 0)
+    {
+        return;
+    } // End if
+    if (n + m - 1 <= limit)
+    {
+        // Nothing reaches the limit once the operands are cut to it
+        if (n == a.size() && m == b.size())
+        {
+            multiplyInto(a, b, out);
+        }
+        else
+        {
+            multiplyInto(std::vector<ItemType>(a.begin(), a.begin() + n), std::vector<ItemType>(b.begin(), b.begin() + m), out);
+        } // End if
+        return;
+    } // End if
+
+    out.assign(limit, static_cast<ItemType>(0));
+    const size_t shorter = std::min(n, m);
+    if (shorter < karatsubaThreshold() || 4 * shorter < limit)
+    {
+        // Schoolbook rows stop at the limit
+        for (size_t i = 0; i < n; i++)
+        {
+            const ItemType ai = a[i];
+            if (ai == 0)
+            {
+                continue;
+            } // End if
+            PolySimd::multiplyAddRow(out.data() + i, b.data(), ai, std::min(m, limit - i));
+        } // End for
+        return;
+    } // End if
+
+    // Balanced, pad both operands to the limit and take the short product
+    std::vector<ItemType> paddedA(limit, static_cast<ItemType>(0));
+    std::vector<ItemType> paddedB(limit, static_cast<ItemType>(0));
+    std::copy(a.begin(), a.begin() + n, paddedA.begin());
+    std::copy(b.begin(), b.begin() + m, paddedB.begin());
+    shortProduct(paddedA.data(), paddedB.data(), limit, out.data());
+}  // End multiplyTruncatedInto
+
+// Reduces a dense polynomial modulo another with long division
+template <class ItemType>
+void PolyKernels<ItemType>::remainder(std::vector<ItemType>& dividend, const std::vector<ItemType>& divisor)
+{
+    const size_t divisorDegree = divisor.size() - 1;
+    const ItemType leading = divisor[divisorDegree];
+
+    // Only the nonzero lower coefficients of the divisor take part in each elimination step
+    std::vector<size_t> nonzero;
+    for (size_t j = 0; j < divisorDegree; j++)
+    {
+        if (divisor[j] != 0)
+        {
+            nonzero.push_back(j);
+        } // End if
+    } // End for
+
+    for (size_t i = dividend.size(); i > divisorDegree; i--)
+    {
+        const size_t top = i - 1;
+        const ItemType quotient = dividend[top] / leading;
+        if (quotient != 0)
+        {
+            const size_t offset = top - divisorDegree;
+            for (size_t j : nonzero)
+            {
+                dividend[offset + j] -= quotient * divisor[j];
+            } // End for
+        } // End if
+        dividend[top] = 0;
+    } // End for
+    if (dividend.size() > divisorDegree)
+    {
+        dividend.resize(divisorDegree);
+    } // End if
+}  // End remainder
+
+// Computes the coefficients of p(x + shift)
+template <class ItemType>
+void PolyKernels<ItemType>::taylorShift(std::vector<ItemType>& coefficients, const ItemType& shift)
+{
+    const size_t length = coefficients.size();
+    if (length < 2 || shift == 0)
+    {
+        return;
+    } // End if
+
+    if (length <= TAYLOR_SHIFT_THRESHOLD)
+    {
+        // Repeated synthetic division by (x - shift), quadratic but with the smallest constant
+        for (size_t i = 0; i + 1 < length; i++)
+        {
+            for (size_t j = length - 1; j > i; j--)
+            {
+                coefficients[j - 1] += shift * coefficients[j];
+            } // End for
+        } // End for
+        return;
+    } // End if
+
+    // Pad to a power of two so every level splits blocks evenly
+    size_t padded = 1;
+    while (padded < length)
+    {
+        padded <<= 1;
+    } // End while
+    coefficients.resize(padded, static_cast<ItemType>(0));
+
+    // Blocks of size 1 are constants and already shifted. Each level merges pairs as low + (x + shift)^m * high
+    std::vector<ItemType> shiftPower = { shift, static_cast<ItemType>(1) }; // (x + shift)^m for the current block size m
+    std::vector<ItemType> high;
+    std::vector<ItemType> product;
+    std::vector<ItemType> nextPower;
+    for (size_t m = 1; m < padded; m <<= 1)
+    {
+        for (size_t start = 0; start < padded; start += 2 * m)
+        {
+            high.assign(coefficients.begin() + start + m, coefficients.begin() + start + 2 * m);
+            multiplyInto(shiftPower, high, product);
+
+            // The product has degree below 2m and replaces the high half, then the low half is added back
+            std::fill(coefficients.begin() + start + m, coefficients.begin() + start + 2 * m, static_cast<ItemType>(0));
+            for (size_t i = 0; i < product.size() && i < 2 * m; i++)
+            {
+                coefficients[start + i] += product[i];
+            } // End for
+        } // End for
+        if (2 * m < padded)
+        {
+            multiplyInto(shiftPower, shiftPower, nextPower);
+            shiftPower.swap(nextPower);
+        } // End if
+    } // End for
+    coefficients.resize(length);
+}  // End taylorShift
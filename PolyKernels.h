@@ -0,0 +1,118 @@
+/** @file PolyKernels.h
+* @class PolyKernels
+* Dense coefficient kernels shared by the SparsePoly operations that work on contiguous runs of powers. A dense polynomial is
+* a vector of coefficients where index i holds the coefficient of the variable to the power i (lowest power first).
+*/
+
+#ifndef POLY_KERNELS_
+#define POLY_KERNELS_
+
+#include "PolySimd.h"
+#include <cstddef>
+#include <vector>
+
+template <class ItemType>
+class PolyKernels
+{
+private:
+    /** Operand length below which Karatsuba multiplication falls back to the scalar schoolbook kernel. */
+    static const size_t KARATSUBA_THRESHOLD = 32;
+
+    /** The same threshold when the schoolbook rows run on the vector kernel, which stays ahead for longer. */
+    static const size_t VECTOR_KARATSUBA_THRESHOLD = 128;
+
+    /** Degree below which the Taylor shift uses the quadratic synthetic division kernel. */
+    static const size_t TAYLOR_SHIFT_THRESHOLD = 32;
+
+    /** Row length below which the schoolbook kernel stays a plain loop instead of calling the vector row kernel. */
+    static const size_t VECTOR_ROW_THRESHOLD = 8;
+
+    /** Bytes of the second operand handled per tile, so the tile and the output window it updates stay in L1. */
+    static const size_t L1_TILE_BYTES = 8192;
+
+    /** Bytes of the first operand handled per block, so the block and its output range stay in L2 across tiles. */
+    static const size_t L2_BLOCK_BYTES = 65536;
+
+    /** @return The operand length below which schoolbook multiplication beats Karatsuba for this type on this processor. */
+    static size_t karatsubaThreshold();
+
+    /** Helper for Karatsuba multiplication of two operands of equal length.
+    * @pre out has room for 2n - 1 coefficients and is zero filled.
+    * @post out holds the product of a and b.
+    * @param a First operand.
+    * @param b Second operand.
+    * @param n Length of each operand.
+    * @param out Receives the product. */
+    static void karatsuba(const ItemType* a, const ItemType* b, size_t n, ItemType* out);
+
+    /** Helper for the short product: adds the low limit coefficients of a * b into out. The low halves are multiplied in full with Karatsuba and the two cross products recurse on the remaining length, so the high half a1 * b1 is never formed.
+    * @pre a and b each hold at least limit coefficients and out has room for limit coefficients.
+    * @post out[k] is increased by the coefficient of power k of a * b for every k below limit.
+    * @param a First operand.
+    * @param b Second operand.
+    * @param limit The number of product coefficients wanted. */
+    static void shortProduct(const ItemType* a, const ItemType* b, size_t limit, ItemType* out);
+
+public:
+    /** Raises a value to a nonnegative integer power by repeated squaring.
+    * @pre None
+    * @post None
+    * @param base The value to raise.
+    * @param exponent The power.
+    * @return base to the power exponent, or 1 if exponent is 0. */
+    static ItemType power(ItemType base, unsigned int exponent);
+
+    /** Adds the product of two coefficient runs into an output run using the quadratic schoolbook method. The convolution
+    * is tiled so the working set stays in cache, and each row runs on the vector kernel of PolySimd.
+    * @pre out has room for n + m - 1 coefficients and does not overlap a or b.
+    * @post out[i + j] is increased by a[i] * b[j] for every pair.
+    * @param a First operand.
+    * @param n Length of the first operand.
+    * @param b Second operand.
+    * @param m Length of the second operand.
+    * @param out Accumulates the product. */
+    static void multiplyAccumulate(const ItemType* a, size_t n, const ItemType* b, size_t m, ItemType* out);
+
+    /** Multiplies two dense polynomials, choosing schoolbook or Karatsuba multiplication by size. The output buffer is reused.
+    * @pre out is not a or b.
+    * @post out holds the product, or is empty if either operand is empty.
+    * @param a First dense operand.
+    * @param b Second dense operand.
+    * @param out Receives the dense product. */
+    static void multiplyInto(const std::vector<ItemType>& a, const std::vector<ItemType>& b, std::vector<ItemType>& out);
+
+    /** Multiplies two dense polynomials.
+    * @pre None
+    * @post None
+    * @param a First dense operand.
+    * @param b Second dense operand.
+    * @return The dense product, or an empty vector if either operand is empty. */
+    static std::vector<ItemType> multiply(const std::vector<ItemType>& a, const std::vector<ItemType>& b);
+
+    /** Multiplies two dense polynomials keeping only the powers below a limit, without computing any coefficient above it. Lopsided operands use a schoolbook loop whose inner bound stops at the limit; balanced ones use a short product.
+    * @pre out is not a or b.
+    * @post out holds the coefficients of powers below limit of the product, at most limit of them, or is empty if either operand is empty.
+    * @param a First dense operand.
+    * @param b Second dense operand.
+    * @param limit One more than the highest power kept.
+    * @param out Receives the truncated dense product. */
+    static void multiplyTruncatedInto(const std::vector<ItemType>& a, const std::vector<ItemType>& b, size_t limit, std::vector<ItemType>& out);
+
+    /** Replaces a dense polynomial by its remainder modulo another, using long division that only touches the nonzero coefficients of the divisor.
+    * @pre The divisor is nonempty with a nonzero leading coefficient. For integer coefficient types the leading coefficient must divide exactly, for example 1 or -1.
+    * @post dividend holds the remainder, with fewer coefficients than the divisor.
+    * @param dividend Dense coefficients to reduce in place.
+    * @param divisor Dense coefficients of the modulus. */
+    static void remainder(std::vector<ItemType>& dividend, const std::vector<ItemType>& divisor);
+
+    /** Computes the dense coefficients of p(x + shift). Small inputs use synthetic division; larger ones use a divide and conquer
+    * split p = low + (x + shift)^m * high with the powers (x + shift)^m built by squaring, so the cost follows the multiplication kernel.
+    * @pre None
+    * @post The coefficients are replaced by those of the shifted polynomial.
+    * @param coefficients Dense coefficients to shift in place.
+    * @param shift The amount to shift the variable by. */
+    static void taylorShift(std::vector<ItemType>& coefficients, const ItemType& shift);
+}; // end PolyKernels
+
+#include "PolyKernels.cpp"
+#endif
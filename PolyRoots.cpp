@@ -0,0 +1,463 @@
+/** @file PolyRoots.cpp
+* Real root isolation and refinement for sparse polynomials with floating point coefficients.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolyRoots.h"
+#include "PolyKernels.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <thread>
+
+// Counts sign variations of (x + 1)^n f(1 / (x + 1))
+template <class ItemType>
+int PolyRoots<ItemType>::descartesBound(const std::vector<ItemType>& coefficients)
+{
+    // Reversing gives x^n f(1 / x), then shifting by 1 maps the interval (0, 1) onto (0, infinity)
+    std::vector<ItemType> transformed(coefficients.rbegin(), coefficients.rend());
+    PolyKernels<ItemType>::taylorShift(transformed, static_cast<ItemType>(1));
+
+    int variations = 0;
+    int previousSign = 0;
+    for (const ItemType& value : transformed)
+    {
+        int sign = (value > 0) - (value < 0);
+        if (sign != 0)
+        {
+            if (previousSign != 0 && sign != previousSign)
+            {
+                variations++;
+            } // End if
+            previousSign = sign;
+        } // End if
+    } // End for
+    return variations;
+}  // End descartesBound
+
+// Vincent-Collins-Akritas bisection on (0, bound)
+template <class ItemType>
+void PolyRoots<ItemType>::isolatePositive(const std::vector<ItemType>& coefficients, ItemType bound,
+    std::vector<std::pair<ItemType, ItemType>>& intervals)
+{
+    // One pending subinterval (a, a + width) of (0, 1), with f mapped so that the subinterval becomes (0, 1)
+    struct Pending
+    {
+        std::vector<ItemType> f;
+        ItemType a;
+        ItemType width;
+        int depth;
+    };
+
+    // Rescales coefficients so the largest magnitude is 1, keeping repeated bisection away from overflow
+    auto normalize = [](std::vector<ItemType>& f)
+    {
+        ItemType largest = 0;
+        for (const ItemType& value : f)
+        {
+            largest = std::max(largest, std::abs(value));
+        } // End for
+        if (largest > 0)
+        {
+            for (ItemType& value : f)
+            {
+                value /= largest;
+            } // End for
+        } // End if
+    };
+
+    // Map the roots in (0, bound) onto (0, 1) with f(x) = p(bound * x), computed in the log domain to avoid overflow
+    const ItemType logBound = std::log(bound);
+    std::vector<ItemType> logs(coefficients.size());
+    ItemType largestLog = -HUGE_VAL;
+    for (size_t i = 0; i < coefficients.size(); i++)
+    {
+        if (coefficients[i] != 0)
+        {
+            logs[i] = std::log(std::abs(coefficients[i])) + static_cast<ItemType>(i) * logBound;
+            largestLog = std::max(largestLog, logs[i]);
+        } // End if
+    } // End for
+    std::vector<ItemType> scaled(coefficients.size(), static_cast<ItemType>(0));
+    for (size_t i = 0; i < coefficients.size(); i++)
+    {
+        if (coefficients[i] != 0)
+        {
+            ItemType magnitude = std::exp(logs[i] - largestLog);
+            scaled[i] = (coefficients[i] < 0) ? -magnitude : magnitude;
+        } // End if
+    } // End for
+
+    std::vector<Pending> stack;
+    stack.push_back(Pending{ scaled, static_cast<ItemType>(0), static_cast<ItemType>(1), 0 });
+    while (!stack.empty())
+    {
+        Pending current = std::move(stack.back());
+        stack.pop_back();
+
+        int variations = descartesBound(current.f);
+        if (variations == 0)
+        {
+            continue; // No roots in this subinterval
+        } // End if
+        if (variations == 1 || current.depth >= MAX_DEPTH)
+        {
+            // Exactly one root, or a cluster too tight to separate in this precision
+            intervals.push_back(std::make_pair(current.a * bound, (current.a + current.width) * bound));
+            continue;
+        } // End if
+
+        // Left half f(x / 2), right half f((x + 1) / 2)
+        const size_t length = current.f.size();
+        Pending left{ std::vector<ItemType>(length), current.a, current.width / 2, current.depth + 1 };
+        for (size_t i = 0; i < length; i++)
+        {
+            left.f[i] = std::ldexp(current.f[i], -static_cast<int>(i));
+        } // End for
+        normalize(left.f);
+        Pending right{ left.f, current.a + current.width / 2, current.width / 2, current.depth + 1 };
+        PolyKernels<ItemType>::taylorShift(right.f, static_cast<ItemType>(1));
+
+        // A root exactly at the midpoint shows up as a zero constant term of the right half
+        if (right.f[0] == 0)
+        {
+            ItemType midpoint = right.a * bound;
+            intervals.push_back(std::make_pair(midpoint, midpoint));
+            while (!right.f.empty() && right.f[0] == 0)
+            {
+                right.f.erase(right.f.begin());
+            } // End while
+        } // End if
+        normalize(right.f);
+
+        if (right.f.size() > 1)
+        {
+            stack.push_back(std::move(right));
+        } // End if
+        stack.push_back(std::move(left));
+    } // End while
+}  // End isolatePositive
+
+// Evaluates p and p' at many points with Horner's method, points innermost
+template <class ItemType>
+void PolyRoots<ItemType>::evaluateWithSlope(const std::vector<ItemType>& coefficients, const ItemType* x, size_t count,
+    ItemType* value, ItemType* slope)
+{
+    const size_t n = coefficients.size();
+    for (size_t i = 0; i < count; i++)
+    {
+        value[i] = coefficients[n - 1];
+        slope[i] = 0;
+    } // End for
+    for (size_t k = n - 1; k > 0; k--)
+    {
+        const ItemType c = coefficients[k - 1];
+        for (size_t i = 0; i < count; i++)
+        {
+            slope[i] = slope[i] * x[i] + value[i];
+            value[i] = value[i] * x[i] + c;
+        } // End for
+    } // End for
+}  // End evaluateWithSlope
+
+template <class ItemType>
+ItemType PolyRoots<ItemType>::squareFreeTolerance()
+{
+    return std::sqrt(std::numeric_limits<ItemType>::epsilon());
+}  // End squareFreeTolerance
+
+// Euclid's algorithm on p and p', each remainder scaled so its largest coefficient is 1 and cut at the tolerance
+template <class ItemType>
+std::vector<ItemType> PolyRoots<ItemType>::squareFreePart(const std::vector<ItemType>& coefficients)
+{
+    // Zeroes the coefficients at or below the tolerance times scale, then rescales the rest so the largest is 1
+    auto normalize = [](std::vector<ItemType>& f, ItemType scale)
+    {
+        ItemType largest = 0;
+        for (ItemType& value : f)
+        {
+            if (std::abs(value) <= squareFreeTolerance() * scale)
+            {
+                value = 0;
+            } // End if
+            largest = std::max(largest, std::abs(value));
+        } // End for
+        while (!f.empty() && f.back() == 0)
+        {
+            f.pop_back();
+        } // End while
+        for (ItemType& value : f)
+        {
+            value /= largest;
+        } // End for
+    };
+    auto largestOf = [](const std::vector<ItemType>& f)
+    {
+        ItemType largest = 0;
+        for (const ItemType& value : f)
+        {
+            largest = std::max(largest, std::abs(value));
+        } // End for
+        return largest;
+    };
+
+    std::vector<ItemType> a = coefficients;
+    std::vector<ItemType> b(coefficients.size() - 1);
+    for (size_t i = 1; i < coefficients.size(); i++)
+    {
+        b[i - 1] = coefficients[i] * static_cast<ItemType>(i);
+    } // End for
+    normalize(a, largestOf(a));
+    normalize(b, largestOf(b));
+    while (b.size() > 1)
+    {
+        // a has largest coefficient 1, so remainder coefficients below the tolerance are rounding left over from a
+        PolyKernels<ItemType>::remainder(a, b);
+        normalize(a, static_cast<ItemType>(1));
+        a.swap(b);
+    } // End while
+    if (!b.empty())
+    {
+        return coefficients; // The gcd is a constant, so p has no repeated factor
+    } // End if
+
+    // p divided by the gcd a, by long division from the top
+    const size_t gcdDegree = a.size() - 1;
+    std::vector<ItemType> dividend = coefficients;
+    std::vector<ItemType> quotient(coefficients.size() - gcdDegree);
+    for (size_t i = quotient.size(); i > 0; i--)
+    {
+        quotient[i - 1] = dividend[i - 1 + gcdDegree] / a[gcdDegree];
+        for (size_t j = 0; j <= gcdDegree; j++)
+        {
+            dividend[i - 1 + j] -= quotient[i - 1] * a[j];
+        } // End for
+    } // End for
+    return quotient;
+}  // End squareFreePart
+
+// Strips x^z, then takes the square free part
+template <class ItemType>
+std::vector<ItemType> PolyRoots<ItemType>::reducedCoefficients(const SparsePoly<ItemType>& poly, bool& hasZeroRoot)
+{
+    std::vector<ItemType> coefficients = poly.toDenseCoefficients();
+    hasZeroRoot = false;
+    if (coefficients.size() < 2)
+    {
+        return coefficients; // Empty or constant polynomial
+    } // End if
+
+    // Factor out x^z, which contributes the root 0
+    size_t zeroPower = 0;
+    while (coefficients[zeroPower] == 0)
+    {
+        zeroPower++;
+    } // End while
+    hasZeroRoot = (zeroPower > 0);
+    coefficients.erase(coefficients.begin(), coefficients.begin() + zeroPower);
+    if (coefficients.size() < 2)
+    {
+        return coefficients;
+    } // End if
+    return squareFreePart(coefficients);
+}  // End reducedCoefficients
+
+// Isolates the positive and negative roots of the reduced polynomial
+template <class ItemType>
+std::vector<std::pair<ItemType, ItemType>> PolyRoots<ItemType>::isolateReduced(std::vector<ItemType> coefficients, bool hasZeroRoot)
+{
+    std::vector<std::pair<ItemType, ItemType>> intervals;
+    if (hasZeroRoot)
+    {
+        intervals.push_back(std::make_pair(static_cast<ItemType>(0), static_cast<ItemType>(0)));
+    } // End if
+    if (coefficients.size() < 2)
+    {
+        return intervals;
+    } // End if
+
+    // Cauchy bound, every root is smaller in magnitude than 1 + max |c_i / c_n|
+    const ItemType leading = coefficients.back();
+    ItemType bound = 0;
+    for (size_t i = 0; i + 1 < coefficients.size(); i++)
+    {
+        bound = std::max(bound, std::abs(coefficients[i] / leading));
+    } // End for
+    bound += 1;
+
+    isolatePositive(coefficients, bound, intervals);
+
+    // Negative roots of p are the positive roots of p(-x)
+    std::vector<std::pair<ItemType, ItemType>> negative;
+    for (size_t i = 1; i < coefficients.size(); i += 2)
+    {
+        coefficients[i] = -coefficients[i];
+    } // End for
+    isolatePositive(coefficients, bound, negative);
+    for (const std::pair<ItemType, ItemType>& interval : negative)
+    {
+        intervals.push_back(std::make_pair(-interval.second, -interval.first));
+    } // End for
+
+    std::sort(intervals.begin(), intervals.end());
+    return intervals;
+}  // End isolateReduced
+
+// Finds isolating intervals for the real roots
+template <class ItemType>
+std::vector<std::pair<ItemType, ItemType>> PolyRoots<ItemType>::isolateRoots(const SparsePoly<ItemType>& poly)
+{
+    bool hasZeroRoot = false;
+    std::vector<ItemType> coefficients = reducedCoefficients(poly, hasZeroRoot);
+    return isolateReduced(std::move(coefficients), hasZeroRoot);
+}  // End isolateRoots
+
+// Isolates and refines the real roots of one polynomial
+template <class ItemType>
+std::vector<ItemType> PolyRoots<ItemType>::realRoots(const SparsePoly<ItemType>& poly, ItemType tolerance)
+{
+    std::vector<ItemType> roots;
+    // Refine against the square free part of p / x^z, so the root 0 cannot capture an interval that ends there and
+    // repeated roots change sign like simple ones
+    bool hasZeroRoot = false;
+    std::vector<ItemType> coefficients = reducedCoefficients(poly, hasZeroRoot);
+    std::vector<std::pair<ItemType, ItemType>> intervals = isolateReduced(coefficients, hasZeroRoot);
+    if (intervals.empty())
+    {
+        return roots;
+    } // End if
+
+    // Refine every interval in lockstep so each Horner pass evaluates all the current iterates together
+    const size_t count = intervals.size();
+    std::vector<ItemType> low(count), high(count), x(count), value(count), slope(count);
+    std::vector<int> lowSign(count);
+    std::vector<bool> done(count, false);
+    for (size_t i = 0; i < count; i++)
+    {
+        low[i] = intervals[i].first;
+        high[i] = intervals[i].second;
+        done[i] = (low[i] == high[i]); // Exact roots need no refinement
+        x[i] = high[i];
+    } // End for
+    evaluateWithSlope(coefficients, x.data(), count, value.data(), slope.data());
+    std::vector<int> highSign(count);
+    for (size_t i = 0; i < count; i++)
+    {
+        highSign[i] = (value[i] > 0) - (value[i] < 0);
+        x[i] = low[i];
+    } // End for
+    evaluateWithSlope(coefficients, x.data(), count, value.data(), slope.data());
+    for (size_t i = 0; i < count; i++)
+    {
+        // An end of the interval may be a neighbouring root found exactly at a bisection point, so use the other end's sign
+        lowSign[i] = (value[i] > 0) - (value[i] < 0);
+        if (lowSign[i] == 0)
+        {
+            lowSign[i] = -highSign[i];
+        } // End if
+        x[i] = (low[i] + high[i]) / 2;
+    } // End for
+
+    for (int iteration = 0; iteration < MAX_ITERATIONS; iteration++)
+    {
+        if (std::find(done.begin(), done.end(), false) == done.end())
+        {
+            break;
+        } // End if
+        evaluateWithSlope(coefficients, x.data(), count, value.data(), slope.data());
+        for (size_t i = 0; i < count; i++)
+        {
+            if (done[i])
+            {
+                continue;
+            } // End if
+            if (value[i] == 0)
+            {
+                done[i] = true;
+                continue;
+            } // End if
+
+            // Shrink the bracket around the sign change
+            int sign = (value[i] > 0) - (value[i] < 0);
+            if (sign == lowSign[i])
+            {
+                low[i] = x[i];
+            }
+            else
+            {
+                high[i] = x[i];
+            } // End if
+
+            // Take the Newton step unless it leaves the bracket, otherwise bisect
+            ItemType next = (low[i] + high[i]) / 2;
+            if (slope[i] != 0)
+            {
+                ItemType newton = x[i] - value[i] / slope[i];
+                if (newton > low[i] && newton < high[i])
+                {
+                    next = newton;
+                } // End if
+            } // End if
+
+            ItemType scale = std::max(static_cast<ItemType>(1), std::abs(x[i]));
+            if (std::abs(next - x[i]) <= tolerance * scale || high[i] - low[i] <= tolerance * scale)
+            {
+                done[i] = true;
+            } // End if
+            x[i] = next;
+        } // End for
+    } // End for
+
+    // Clusters, and repeated roots the square free part missed, can refine to nearly the same root. Roots closer than
+    // the square root of the gcd tolerance are already beyond what the gcd separates, so keep each such root once
+    roots = x;
+    std::sort(roots.begin(), roots.end());
+    const ItemType separation = std::max(tolerance, std::sqrt(squareFreeTolerance()));
+    std::vector<ItemType> distinct;
+    for (const ItemType& root : roots)
+    {
+        if (distinct.empty() || std::abs(root - distinct.back()) > separation * std::max(static_cast<ItemType>(1), std::abs(root)))
+        {
+            distinct.push_back(root);
+        } // End if
+    } // End for
+    return distinct;
+}  // End realRoots
+
+// Finds the real roots of many polynomials on a group of worker threads
+template <class ItemType>
+std::vector<std::vector<ItemType>> PolyRoots<ItemType>::realRootsBatch(const std::vector<SparsePoly<ItemType>>& polys,
+    unsigned int threadCount, ItemType tolerance)
+{
+    std::vector<std::vector<ItemType>> results(polys.size());
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    } // End if
+    threadCount = static_cast<unsigned int>(std::min<size_t>(threadCount, polys.size()));
+
+    // Workers claim polynomials one at a time so uneven degrees balance out
+    std::atomic<size_t> nextIndex(0);
+    auto worker = [&]()
+    {
+        for (size_t i = nextIndex++; i < polys.size(); i = nextIndex++)
+        {
+            results[i] = realRoots(polys[i], tolerance);
+        } // End for
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int t = 1; t < threadCount; t++)
+    {
+        threads.push_back(std::thread(worker));
+    } // End for
+    worker(); // The calling thread works too
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    } // End for
+    return results;
+}  // End realRootsBatch
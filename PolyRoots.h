@@ -0,0 +1,114 @@
+/** @file PolyRoots.h
+* @class PolyRoots
+* Real root finding for sparse polynomials with floating point coefficients. Roots are isolated with Descartes' rule of
+* signs using the Vincent-Collins-Akritas bisection, then each isolating interval is refined with a safeguarded Newton
+* iteration that falls back to bisection whenever a step leaves the bracket. Both steps work on the square free part
+* p / gcd(p, p'), which has the same distinct roots as p but each of multiplicity one, so repeated roots are isolated and
+* refined like simple ones. The gcd is computed in floating point, treating remainder coefficients below the square root of
+* the machine epsilon relative to the dividend as zero. The remainders of two roots a distance d apart shrink like d^2, so
+* distinct roots closer than about the fourth root of the epsilon (1e-4 relative, in double) are reported as one, and
+* several roots of multiplicity three or more in one polynomial can still be split or lost.
+*/
+
+#ifndef POLY_ROOTS_
+#define POLY_ROOTS_
+
+#include "SparsePoly.h"
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+template <class ItemType>
+class PolyRoots
+{
+    static_assert(std::is_floating_point<ItemType>::value, "PolyRoots requires a floating point coefficient type");
+
+private:
+    /** Maximum number of bisections of one interval before it is treated as a cluster of roots. */
+    static const int MAX_DEPTH = 60;
+
+    /** Maximum number of refinement steps for one root. */
+    static const int MAX_ITERATIONS = 100;
+
+    /** @return The relative size below which a remainder coefficient of the gcd of p and p' is treated as zero: the square
+    * root of the machine epsilon of ItemType. */
+    static ItemType squareFreeTolerance();
+
+    /** Helper that computes the square free part p / gcd(p, p') with Euclid's algorithm.
+    * @pre coefficients holds at least 2 dense coefficients, lowest power first, with a nonzero leading coefficient.
+    * @post None
+    * @param coefficients Dense coefficients of p.
+    * @return Dense coefficients of the square free part, or of p itself if p has no repeated factor. */
+    static std::vector<ItemType> squareFreePart(const std::vector<ItemType>& coefficients);
+
+    /** Helper that strips the factor x^z and repeated factors from a polynomial.
+    * @pre None
+    * @post None
+    * @param poly The polynomial.
+    * @param hasZeroRoot Receives true if 0 is a root.
+    * @return Dense coefficients of the square free part of p / x^z, lowest power first; fewer than 2 if it has no roots. */
+    static std::vector<ItemType> reducedCoefficients(const SparsePoly<ItemType>& poly, bool& hasZeroRoot);
+
+    /** Helper that isolates the roots of reduced coefficients, adding the root 0 if it was stripped.
+    * @pre coefficients comes from reducedCoefficients.
+    * @post None
+    * @return Intervals sorted from lowest to highest. */
+    static std::vector<std::pair<ItemType, ItemType>> isolateReduced(std::vector<ItemType> coefficients, bool hasZeroRoot);
+
+    /** Helper that counts the sign variations of the Descartes transform (x + 1)^n f(1 / (x + 1)), bounding the number of roots of f in (0, 1).
+    * @pre None
+    * @post Does not change the coefficients.
+    * @param coefficients Dense coefficients of f, lowest power first.
+    * @return The number of sign variations. */
+    static int descartesBound(const std::vector<ItemType>& coefficients);
+
+    /** Helper that isolates the roots of a polynomial in the open interval (0, bound).
+    * @pre The constant coefficient is nonzero.
+    * @post None
+    * @param coefficients Dense coefficients, lowest power first.
+    * @param bound Upper bound on the positive roots.
+    * @param intervals Receives the isolating intervals; intervals of zero width are exact roots. */
+    static void isolatePositive(const std::vector<ItemType>& coefficients, ItemType bound, std::vector<std::pair<ItemType, ItemType>>& intervals);
+
+    /** Helper that evaluates a dense polynomial and its derivative at many points at once, looping over points innermost so the loop vectorizes.
+    * @pre value and slope have room for count entries.
+    * @post value[i] and slope[i] hold p(x[i]) and p'(x[i]).
+    * @param coefficients Dense coefficients, lowest power first.
+    * @param x The points.
+    * @param count The number of points.
+    * @param value Receives the values.
+    * @param slope Receives the derivatives. */
+    static void evaluateWithSlope(const std::vector<ItemType>& coefficients, const ItemType* x, size_t count, ItemType* value, ItemType* slope);
+
+public:
+    /** Finds isolating intervals for the distinct real roots of a polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param poly The polynomial.
+    * @return Intervals sorted from lowest to highest, each holding exactly one distinct root (or a tight cluster), once
+    * whatever its multiplicity. Intervals of zero width are exact roots. */
+    static std::vector<std::pair<ItemType, ItemType>> isolateRoots(const SparsePoly<ItemType>& poly);
+
+    /** Finds the distinct real roots of a polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param poly The polynomial.
+    * @param tolerance Relative tolerance at which refinement stops.
+    * @return The roots sorted from lowest to highest, each once whatever its multiplicity, or an empty vector if the
+    * polynomial is empty or constant. */
+    static std::vector<ItemType> realRoots(const SparsePoly<ItemType>& poly, ItemType tolerance = static_cast<ItemType>(1e-12));
+
+    /** Finds the distinct real roots of many polynomials in parallel.
+    * @pre None
+    * @post Does not change the polynomials.
+    * @param polys The polynomials.
+    * @param threadCount Number of worker threads, or 0 to use the hardware concurrency.
+    * @param tolerance Relative tolerance at which refinement stops.
+    * @return One vector of roots per polynomial, in the same order as the input. */
+    static std::vector<std::vector<ItemType>> realRootsBatch(const std::vector<SparsePoly<ItemType>>& polys, unsigned int threadCount = 0,
+        ItemType tolerance = static_cast<ItemType>(1e-12));
+}; // end PolyRoots
+
+#include "PolyRoots.cpp"
+#endif
@@ -0,0 +1,202 @@
+/** @file PolySimd.cpp
+* Row kernels for the dense multiply kernels with run time instruction set dispatch. This file is included by its
+* header, so the non-template functions are inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "PolySimd.h"
+#include <cstdint>
+
+#ifdef POLY_SIMD_X86
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#endif
+
+template <class ItemType>
+constexpr int PolySimd::rowKind()
+{
+    return std::is_same<ItemType, double>::value ? DOUBLE_ROW
+        : std::is_same<ItemType, float>::value ? FLOAT_ROW
+        : (std::is_integral<ItemType>::value && !std::is_same<ItemType, bool>::value && sizeof(ItemType) == 4) ? INT32_ROW
+        : (std::is_integral<ItemType>::value && sizeof(ItemType) == 8) ? INT64_ROW
+        : GENERIC_ROW;
+}  // End rowKind
+
+template <class ItemType>
+void PolySimd::scalarRow(ItemType* out, const ItemType* b, ItemType scale, size_t length)
+{
+    for (size_t k = 0; k < length; k++)
+    {
+        out[k] += scale * b[k];
+    } // End for
+}  // End scalarRow
+
+inline bool PolySimd::hasAvx2()
+{
+#if defined(POLY_SIMD_X86) && defined(_MSC_VER) && !defined(__clang__)
+    // AVX2 needs the CPU flag and the operating system saving the YMM registers
+    static const bool supported = []()
+    {
+        int info[4];
+        __cpuid(info, 1);
+        const bool osSaves = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        __cpuidex(info, 7, 0);
+        return osSaves && (info[1] & (1 << 5)) != 0;
+    }();
+    return supported;
+#elif defined(POLY_SIMD_X86)
+    static const bool supported = __builtin_cpu_supports("avx2") != 0;
+    return supported;
+#else
+    return false;
+#endif
+}  // End hasAvx2
+
+template <class ItemType>
+PolySimd::RowKernel<ItemType> PolySimd::pickRow(RowTag<GENERIC_ROW>)
+{
+    return &scalarRow<ItemType>;
+}  // End pickRow
+
+template <class ItemType>
+PolySimd::RowKernel<ItemType> PolySimd::pickRow(RowTag<DOUBLE_ROW>)
+{
+#ifdef POLY_SIMD_X86
+    if (hasAvx2())
+    {
+        return &avx2RowDouble;
+    } // End if
+#endif
+    return &scalarRow<ItemType>;
+}  // End pickRow
+
+template <class ItemType>
+PolySimd::RowKernel<ItemType> PolySimd::pickRow(RowTag<FLOAT_ROW>)
+{
+#ifdef POLY_SIMD_X86
+    if (hasAvx2())
+    {
+        return &avx2RowFloat;
+    } // End if
+#endif
+    return &scalarRow<ItemType>;
+}  // End pickRow
+
+template <class ItemType>
+PolySimd::RowKernel<ItemType> PolySimd::pickRow(RowTag<INT32_ROW>)
+{
+#ifdef POLY_SIMD_X86
+    if (hasAvx2())
+    {
+        return &avx2RowInt32<ItemType>;
+    } // End if
+#endif
+    return &scalarRow<ItemType>;
+}  // End pickRow
+
+template <class ItemType>
+PolySimd::RowKernel<ItemType> PolySimd::pickRow(RowTag<INT64_ROW>)
+{
+#ifdef POLY_SIMD_X86
+    if (hasAvx2())
+    {
+        return &avx2RowInt64<ItemType>;
+    } // End if
+#endif
+    return &scalarRow<ItemType>;
+}  // End pickRow
+
+#ifdef POLY_SIMD_X86
+// Two vectors per step keep two independent add chains in flight
+inline POLY_SIMD_TARGET_AVX2 void PolySimd::avx2RowDouble(double* out, const double* b, double scale, size_t length)
+{
+    const __m256d factor = _mm256_set1_pd(scale);
+    size_t k = 0;
+    for (; k + 8 <= length; k += 8)
+    {
+        __m256d low = _mm256_add_pd(_mm256_loadu_pd(out + k), _mm256_mul_pd(factor, _mm256_loadu_pd(b + k)));
+        __m256d high = _mm256_add_pd(_mm256_loadu_pd(out + k + 4), _mm256_mul_pd(factor, _mm256_loadu_pd(b + k + 4)));
+        _mm256_storeu_pd(out + k, low);
+        _mm256_storeu_pd(out + k + 4, high);
+    } // End for
+    for (; k < length; k++)
+    {
+        out[k] += scale * b[k];
+    } // End for
+}  // End avx2RowDouble
+
+inline POLY_SIMD_TARGET_AVX2 void PolySimd::avx2RowFloat(float* out, const float* b, float scale, size_t length)
+{
+    const __m256 factor = _mm256_set1_ps(scale);
+    size_t k = 0;
+    for (; k + 16 <= length; k += 16)
+    {
+        __m256 low = _mm256_add_ps(_mm256_loadu_ps(out + k), _mm256_mul_ps(factor, _mm256_loadu_ps(b + k)));
+        __m256 high = _mm256_add_ps(_mm256_loadu_ps(out + k + 8), _mm256_mul_ps(factor, _mm256_loadu_ps(b + k + 8)));
+        _mm256_storeu_ps(out + k, low);
+        _mm256_storeu_ps(out + k + 8, high);
+    } // End for
+    for (; k < length; k++)
+    {
+        out[k] += scale * b[k];
+    } // End for
+}  // End avx2RowFloat
+
+// Integer lanes wrap on overflow, so signed and unsigned types share the kernel
+template <class ItemType>
+POLY_SIMD_TARGET_AVX2 void PolySimd::avx2RowInt32(ItemType* out, const ItemType* b, ItemType scale, size_t length)
+{
+    const __m256i factor = _mm256_set1_epi32(static_cast<int>(scale));
+    size_t k = 0;
+    for (; k + 8 <= length; k += 8)
+    {
+        __m256i* target = reinterpret_cast<__m256i*>(out + k);
+        __m256i product = _mm256_mullo_epi32(factor, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k)));
+        _mm256_storeu_si256(target, _mm256_add_epi32(_mm256_loadu_si256(target), product));
+    } // End for
+    for (; k < length; k++)
+    {
+        out[k] = static_cast<ItemType>(static_cast<std::uint32_t>(out[k]) + static_cast<std::uint32_t>(scale) * static_cast<std::uint32_t>(b[k]));
+    } // End for
+}  // End avx2RowInt32
+
+// AVX2 has no 64 bit multiply: the low 64 bits are lo*lo + ((lo*hi + hi*lo) << 32) from 32 bit products
+template <class ItemType>
+POLY_SIMD_TARGET_AVX2 void PolySimd::avx2RowInt64(ItemType* out, const ItemType* b, ItemType scale, size_t length)
+{
+    const __m256i factorLow = _mm256_set1_epi64x(static_cast<long long>(scale));
+    const __m256i factorHigh = _mm256_srli_epi64(factorLow, 32);
+    size_t k = 0;
+    for (; k + 4 <= length; k += 4)
+    {
+        __m256i* target = reinterpret_cast<__m256i*>(out + k);
+        const __m256i value = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + k));
+        const __m256i lowLow = _mm256_mul_epu32(value, factorLow);
+        const __m256i cross = _mm256_add_epi64(_mm256_mul_epu32(value, factorHigh), _mm256_mul_epu32(_mm256_srli_epi64(value, 32), factorLow));
+        const __m256i product = _mm256_add_epi64(lowLow, _mm256_slli_epi64(cross, 32));
+        _mm256_storeu_si256(target, _mm256_add_epi64(_mm256_loadu_si256(target), product));
+    } // End for
+    for (; k < length; k++)
+    {
+        out[k] = static_cast<ItemType>(static_cast<std::uint64_t>(out[k]) + static_cast<std::uint64_t>(scale) * static_cast<std::uint64_t>(b[k]));
+    } // End for
+}  // End avx2RowInt64
+#endif
+
+template <class ItemType>
+bool PolySimd::vectorizes()
+{
+    return rowKind<ItemType>() != GENERIC_ROW && hasAvx2();
+}  // End vectorizes
+
+// The kernel is chosen on first use for each coefficient type
+template <class ItemType>
+void PolySimd::multiplyAddRow(ItemType* out, const ItemType* b, ItemType scale, size_t length)
+{
+    static const RowKernel<ItemType> kernel = pickRow<ItemType>(RowTag<rowKind<ItemType>()>());
+    kernel(out, b, scale, length);
+}  // End multiplyAddRow
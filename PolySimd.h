@@ -0,0 +1,91 @@
+/** @file PolySimd.h
+* @class PolySimd
+* Vector row kernel for the dense multiply kernels, picked at run time. On x86 processors with AVX2 the update
+* out[k] += scale * b[k] runs 256 bits at a time for double, float and 32 and 64 bit integer coefficients; every other
+* type and processor uses the scalar loop. Floating point lanes multiply and then add, as the scalar loop does, so both
+* paths give identical results. Defining POLY_SIMD_DISABLE forces the scalar loop.
+*/
+
+#ifndef POLY_SIMD_
+#define POLY_SIMD_
+
+#include <cstddef>
+#include <type_traits>
+
+#if !defined(POLY_SIMD_DISABLE) && (defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86))
+#define POLY_SIMD_X86 1
+#if defined(__GNUC__) || defined(__clang__)
+#define POLY_SIMD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define POLY_SIMD_TARGET_AVX2
+#endif
+#endif
+
+class PolySimd
+{
+private:
+    /** Vector kernels available for a coefficient type. */
+    enum RowKind { GENERIC_ROW, DOUBLE_ROW, FLOAT_ROW, INT32_ROW, INT64_ROW };
+
+    template <class ItemType>
+    using RowKernel = void (*)(ItemType*, const ItemType*, ItemType, size_t);
+
+    template <int Kind>
+    using RowTag = std::integral_constant<int, Kind>;
+
+    /** @return The kind of row kernel for a coefficient type. */
+    template <class ItemType>
+    static constexpr int rowKind();
+
+    /** Portable row update. */
+    template <class ItemType>
+    static void scalarRow(ItemType* out, const ItemType* b, ItemType scale, size_t length);
+
+    /** Helpers that pick the row kernel for a type once the processor's features are known. */
+    template <class ItemType>
+    static RowKernel<ItemType> pickRow(RowTag<GENERIC_ROW>);
+    template <class ItemType>
+    static RowKernel<ItemType> pickRow(RowTag<DOUBLE_ROW>);
+    template <class ItemType>
+    static RowKernel<ItemType> pickRow(RowTag<FLOAT_ROW>);
+    template <class ItemType>
+    static RowKernel<ItemType> pickRow(RowTag<INT32_ROW>);
+    template <class ItemType>
+    static RowKernel<ItemType> pickRow(RowTag<INT64_ROW>);
+
+#ifdef POLY_SIMD_X86
+    POLY_SIMD_TARGET_AVX2 static void avx2RowDouble(double* out, const double* b, double scale, size_t length);
+    POLY_SIMD_TARGET_AVX2 static void avx2RowFloat(float* out, const float* b, float scale, size_t length);
+    template <class ItemType>
+    POLY_SIMD_TARGET_AVX2 static void avx2RowInt32(ItemType* out, const ItemType* b, ItemType scale, size_t length);
+    template <class ItemType>
+    POLY_SIMD_TARGET_AVX2 static void avx2RowInt64(ItemType* out, const ItemType* b, ItemType scale, size_t length);
+#endif
+
+public:
+    /** Checks once whether the processor and operating system support AVX2.
+    * @pre None
+    * @post None
+    * @return True if the AVX2 kernels can run. Always false off x86 or with POLY_SIMD_DISABLE. */
+    static bool hasAvx2();
+
+    /** Checks whether multiplyAddRow runs a vector kernel for a coefficient type.
+    * @pre None
+    * @post None
+    * @return True if the type has a vector kernel and the processor supports it. */
+    template <class ItemType>
+    static bool vectorizes();
+
+    /** Adds a multiple of one coefficient run to another: out[k] += scale * b[k] for every k below length.
+    * @pre out and b do not overlap.
+    * @post out is updated.
+    * @param out The run being accumulated into.
+    * @param b The run being scaled.
+    * @param scale The multiplier.
+    * @param length Number of coefficients. */
+    template <class ItemType>
+    static void multiplyAddRow(ItemType* out, const ItemType* b, ItemType scale, size_t length);
+}; // end PolySimd
+
+#include "PolySimd.cpp"
+#endif
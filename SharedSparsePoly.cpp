@@ -0,0 +1,443 @@
+/** @file SharedSparsePoly.cpp
+* Lock-free readable sparse polynomial built from immutable versions and copy-on-write term blocks. This file is included
+* by its header, so the non-template functions are inline.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "SharedSparsePoly.h"
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+// Epochs start at 1 so that no announced epoch equals IDLE
+inline PolyEpochDomain::State::State() : globalEpoch(1)
+{
+    for (size_t i = 0; i < SLOT_COUNT; i++)
+    {
+        slots[i].epoch.store(IDLE, std::memory_order_relaxed);
+        slots[i].claimed.store(false, std::memory_order_relaxed);
+    } // End for
+}  // End constructor
+
+inline PolyEpochDomain::State& PolyEpochDomain::state()
+{
+    static State shared;
+    return shared;
+}  // End state
+
+inline PolyEpochDomain::ThreadSlot& PolyEpochDomain::threadSlot()
+{
+    static thread_local ThreadSlot mine;
+    return mine;
+}  // End threadSlot
+
+// Claims a free slot, waiting if every slot is taken by a live thread
+inline PolyEpochDomain::ThreadSlot::ThreadSlot() : slot(nullptr), depth(0)
+{
+    State& shared = state();
+    while (slot == nullptr)
+    {
+        for (size_t i = 0; i < SLOT_COUNT && slot == nullptr; i++)
+        {
+            bool expected = false;
+            if (!shared.slots[i].claimed.load(std::memory_order_relaxed) &&
+                shared.slots[i].claimed.compare_exchange_strong(expected, true, std::memory_order_acquire))
+            {
+                slot = &shared.slots[i];
+            } // End if
+        } // End for
+        if (slot == nullptr)
+        {
+            std::this_thread::yield();
+        } // End if
+    } // End while
+}  // End constructor
+
+inline PolyEpochDomain::ThreadSlot::~ThreadSlot()
+{
+    slot->epoch.store(IDLE, std::memory_order_seq_cst);
+    slot->claimed.store(false, std::memory_order_release);
+}  // End destructor
+
+// The announcement is sequentially consistent with the writer's exchange and scan, so either the writer sees this
+// reader's epoch or this reader sees the writer's new version
+inline void PolyEpochDomain::enter()
+{
+    ThreadSlot& mine = threadSlot();
+    if (mine.depth++ == 0)
+    {
+        mine.slot->epoch.store(state().globalEpoch.load(std::memory_order_seq_cst), std::memory_order_seq_cst);
+    } // End if
+}  // End enter
+
+inline void PolyEpochDomain::leave()
+{
+    ThreadSlot& mine = threadSlot();
+    if (--mine.depth == 0)
+    {
+        mine.slot->epoch.store(IDLE, std::memory_order_release);
+    } // End if
+}  // End leave
+
+inline std::uint64_t PolyEpochDomain::advance()
+{
+    return state().globalEpoch.fetch_add(1, std::memory_order_seq_cst);
+}  // End advance
+
+// A reader that announced an epoch after retireEpoch started after the version was unpublished
+inline bool PolyEpochDomain::isQuiescent(std::uint64_t retireEpoch)
+{
+    State& shared = state();
+    for (size_t i = 0; i < SLOT_COUNT; i++)
+    {
+        if (shared.slots[i].epoch.load(std::memory_order_seq_cst) <= retireEpoch)
+        {
+            return false;
+        } // End if
+    } // End for
+    return true;
+}  // End isQuiescent
+
+inline PolyEpochGuard::PolyEpochGuard()
+{
+    PolyEpochDomain::enter();
+}  // End constructor
+
+inline PolyEpochGuard::~PolyEpochGuard()
+{
+    PolyEpochDomain::leave();
+}  // End destructor
+
+// Default constructor
+template <class ItemType>
+SharedSparsePoly<ItemType>::SharedSparsePoly() : current(new Version{ {}, 'x', 0, 0 })
+{ }  // End default constructor
+
+// Constructor allowing custom variable character
+template <class ItemType>
+SharedSparsePoly<ItemType>::SharedSparsePoly(char var) : current(new Version{ {}, var, 0, 0 })
+{ }  // End variable constructor
+
+// Constructor publishing an existing polynomial
+template <class ItemType>
+SharedSparsePoly<ItemType>::SharedSparsePoly(const SparsePoly<ItemType>& initial) : current(new Version{ {}, initial.getVariable(), 0, 0 })
+{
+    assign(initial);
+}  // End constructor
+
+// Binary search for the first block whose lowest power is not above the given power
+template <class ItemType>
+size_t SharedSparsePoly<ItemType>::findBlock(const Version& version, unsigned int power)
+{
+    size_t low = 0;
+    size_t high = version.blocks.size() - 1; // The last block takes every power below the others
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (version.blocks[middle]->terms.back().getPower() > power)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        } // End if
+    } // End while
+    return low;
+}  // End findBlock
+
+template <class ItemType>
+size_t SharedSparsePoly<ItemType>::findTerm(const Block& block, unsigned int power)
+{
+    size_t low = 0;
+    size_t high = block.terms.size();
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (block.terms[middle].getPower() > power)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        } // End if
+    } // End while
+    return low;
+}  // End findTerm
+
+template <class ItemType>
+void SharedSparsePoly<ItemType>::applyChange(Version& version, std::vector<bool>& fresh, const ItemType& newCoefficient, unsigned int power)
+{
+    if (version.blocks.empty())
+    {
+        if (newCoefficient != 0)
+        {
+            std::shared_ptr<Block> block = std::make_shared<Block>();
+            block->terms.push_back(Node<ItemType>(newCoefficient, power));
+            version.blocks.push_back(block);
+            fresh.push_back(true);
+            version.termCount++;
+        } // End if
+        return;
+    } // End if
+
+    const size_t blockIndex = findBlock(version, power);
+    const Block& found = *version.blocks[blockIndex];
+    size_t termIndex = findTerm(found, power);
+    const bool exists = termIndex < found.terms.size() && found.terms[termIndex].getPower() == power;
+    if (!exists && newCoefficient == 0)
+    {
+        return; // Removing a term that is not there leaves the block shared
+    } // End if
+
+    // Copy the block the first time this version changes it; blocks created for this version are changed in place
+    if (!fresh[blockIndex])
+    {
+        version.blocks[blockIndex] = std::make_shared<Block>(found);
+        fresh[blockIndex] = true;
+    } // End if
+    Block& block = const_cast<Block&>(*version.blocks[blockIndex]);
+
+    if (exists && newCoefficient == 0)
+    {
+        block.terms.erase(block.terms.begin() + termIndex);
+        version.termCount--;
+        if (block.terms.empty())
+        {
+            version.blocks.erase(version.blocks.begin() + blockIndex);
+            fresh.erase(fresh.begin() + blockIndex);
+        } // End if
+    }
+    else if (exists)
+    {
+        block.terms[termIndex].setCoefficient(newCoefficient);
+    }
+    else
+    {
+        block.terms.insert(block.terms.begin() + termIndex, Node<ItemType>(newCoefficient, power));
+        version.termCount++;
+        if (block.terms.size() >= 2 * BLOCK_TERMS)
+        {
+            // Split so later updates to either half copy only BLOCK_TERMS terms
+            std::shared_ptr<Block> lower = std::make_shared<Block>();
+            lower->terms.assign(block.terms.begin() + BLOCK_TERMS, block.terms.end());
+            block.terms.resize(BLOCK_TERMS);
+            version.blocks.insert(version.blocks.begin() + blockIndex + 1, lower);
+            fresh.insert(fresh.begin() + blockIndex + 1, true);
+        } // End if
+    } // End if
+}  // End applyChange
+
+// Swaps in the new version, then retires the old one under the epoch that the swap ended
+template <class ItemType>
+void SharedSparsePoly<ItemType>::publish(const Version* next)
+{
+    const Version* previous = current.exchange(next, std::memory_order_seq_cst);
+    retired.push_back(std::make_pair(PolyEpochDomain::advance(), previous));
+    reclaimRetired();
+}  // End publish
+
+template <class ItemType>
+void SharedSparsePoly<ItemType>::reclaimRetired()
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < retired.size(); i++)
+    {
+        if (PolyEpochDomain::isQuiescent(retired[i].first))
+        {
+            delete retired[i].second; // Drops this version's references to its blocks
+        }
+        else
+        {
+            retired[kept++] = retired[i];
+        } // End if
+    } // End for
+    retired.resize(kept);
+}  // End reclaimRetired
+
+template <class ItemType>
+template <class Visitor>
+void SharedSparsePoly<ItemType>::visitTerms(const Version& version, Visitor&& visit)
+{
+    for (const std::shared_ptr<const Block>& block : version.blocks)
+    {
+        for (const Node<ItemType>& term : block->terms)
+        {
+            visit(term.getCoefficient(), term.getPower());
+        } // End for
+    } // End for
+}  // End visitTerms
+
+template <class ItemType>
+int SharedSparsePoly<ItemType>::changeCoefficient(ItemType newCoefficient, unsigned int power)
+{
+    changeCoefficients(std::vector<Node<ItemType>>(1, Node<ItemType>(newCoefficient, power)));
+    return 0;
+}  // End changeCoefficient
+
+// Builds one new version that shares every block the changes do not touch
+template <class ItemType>
+void SharedSparsePoly<ItemType>::changeCoefficients(const std::vector<Node<ItemType>>& changes)
+{
+    std::lock_guard<std::mutex> guard(writerLock);
+    const Version* base = current.load(std::memory_order_relaxed); // Only writers change current
+    Version* next = new Version(*base);
+    next->number = base->number + 1;
+    std::vector<bool> fresh(next->blocks.size(), false);
+    for (const Node<ItemType>& change : changes)
+    {
+        applyChange(*next, fresh, change.getCoefficient(), change.getPower());
+    } // End for
+    publish(next);
+}  // End changeCoefficients
+
+template <class ItemType>
+void SharedSparsePoly<ItemType>::assign(const SparsePoly<ItemType>& somePoly)
+{
+    Version* next = new Version{ {}, somePoly.getVariable(), 0, 0 };
+    std::shared_ptr<Block> block;
+    somePoly.forEachTerm([&](const ItemType& coefficient, unsigned int power)
+    {
+        if (!block || block->terms.size() == BLOCK_TERMS)
+        {
+            block = std::make_shared<Block>();
+            block->terms.reserve(BLOCK_TERMS);
+            next->blocks.push_back(block);
+        } // End if
+        block->terms.push_back(Node<ItemType>(coefficient, power));
+        next->termCount++;
+    });
+
+    std::lock_guard<std::mutex> guard(writerLock);
+    next->number = current.load(std::memory_order_relaxed)->number + 1;
+    publish(next);
+}  // End assign
+
+template <class ItemType>
+void SharedSparsePoly<ItemType>::clear()
+{
+    std::lock_guard<std::mutex> guard(writerLock);
+    const Version* base = current.load(std::memory_order_relaxed);
+    publish(new Version{ {}, base->variable, 0, base->number + 1 });
+}  // End clear
+
+template <class ItemType>
+unsigned int SharedSparsePoly<ItemType>::degree() const
+{
+    PolyEpochGuard reading;
+    const Version* version = current.load(std::memory_order_seq_cst);
+    if (version->blocks.empty())
+    {
+        return -1; // Polynomial is empty
+    } // End if
+    return version->blocks.front()->terms.front().getPower();
+}  // End degree
+
+template <class ItemType>
+ItemType SharedSparsePoly<ItemType>::coefficient(unsigned int power) const
+{
+    PolyEpochGuard reading;
+    const Version* version = current.load(std::memory_order_seq_cst);
+    if (version->blocks.empty())
+    {
+        return 0;
+    } // End if
+    const Block& block = *version->blocks[findBlock(*version, power)];
+    size_t termIndex = findTerm(block, power);
+    if (termIndex < block.terms.size() && block.terms[termIndex].getPower() == power)
+    {
+        return block.terms[termIndex].getCoefficient();
+    } // End if
+    return 0;
+}  // End coefficient
+
+template <class ItemType>
+std::string SharedSparsePoly<ItemType>::displayPoly() const
+{
+    PolyEpochGuard reading;
+    const Version* version = current.load(std::memory_order_seq_cst); // Loaded once so the variable and the terms match
+    return this->formatTerms(version->variable, [version](auto&& visit) { visitTerms(*version, visit); });
+}  // End displayPoly
+
+template <class ItemType>
+bool SharedSparsePoly<ItemType>::isEmpty() const
+{
+    PolyEpochGuard reading;
+    return current.load(std::memory_order_seq_cst)->termCount == 0;
+}  // End isEmpty
+
+template <class ItemType>
+char SharedSparsePoly<ItemType>::getVariable() const
+{
+    PolyEpochGuard reading;
+    return current.load(std::memory_order_seq_cst)->variable;
+}  // End getVariable
+
+template <class ItemType>
+int SharedSparsePoly<ItemType>::getTermCount() const
+{
+    PolyEpochGuard reading;
+    return current.load(std::memory_order_seq_cst)->termCount;
+}  // End getTermCount
+
+template <class ItemType>
+std::uint64_t SharedSparsePoly<ItemType>::getVersion() const
+{
+    PolyEpochGuard reading;
+    return current.load(std::memory_order_seq_cst)->number;
+}  // End getVersion
+
+template <class ItemType>
+template <class Visitor>
+void SharedSparsePoly<ItemType>::forEachTerm(Visitor&& visit) const
+{
+    PolyEpochGuard reading;
+    visitTerms(*current.load(std::memory_order_seq_cst), visit);
+}  // End forEachTerm
+
+// Horner's rule over one version, raising x only across gaps between powers
+template <class ItemType>
+ItemType SharedSparsePoly<ItemType>::evaluate(ItemType x) const
+{
+    PolyEpochGuard reading;
+    ItemType result = 0;
+    bool first = true;
+    unsigned int previousPower = 0;
+    visitTerms(*current.load(std::memory_order_seq_cst), [&](const ItemType& coefficient, unsigned int power)
+    {
+        result = first ? coefficient : result * PolyKernels<ItemType>::power(x, previousPower - power) + coefficient;
+        first = false;
+        previousPower = power;
+    });
+    return first ? result : result * PolyKernels<ItemType>::power(x, previousPower);
+}  // End evaluate
+
+template <class ItemType>
+SparsePoly<ItemType> SharedSparsePoly<ItemType>::toSparsePoly() const
+{
+    PolyEpochGuard reading;
+    const Version* version = current.load(std::memory_order_seq_cst);
+    SparsePoly<ItemType> result(version->variable);
+    std::vector<Node<ItemType>> terms;
+    terms.reserve(static_cast<size_t>(version->termCount));
+    visitTerms(*version, [&terms](const ItemType& coefficient, unsigned int power)
+    {
+        terms.push_back(Node<ItemType>(coefficient, power));
+    });
+    result.assignTerms(terms);
+    return result;
+}  // End toSparsePoly
+
+// Destructor
+template <class ItemType>
+SharedSparsePoly<ItemType>::~SharedSparsePoly()
+{
+    for (const std::pair<std::uint64_t, const Version*>& entry : retired)
+    {
+        delete entry.second;
+    } // End for
+    delete current.load(std::memory_order_relaxed);
+}  // End destructor
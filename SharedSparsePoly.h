@@ -0,0 +1,278 @@
+/** @file SharedSparsePoly.h
+* @class SharedSparsePoly
+* Sparse polynomial that many threads can read while one thread at a time updates it. Every published state is an
+* immutable version; readers load the current version with one atomic read and never take a lock, and writers (which
+* serialise on a mutex) build a new version and publish it with an atomic exchange. The terms of a version are split
+* into blocks that are shared between versions, so an update copies only the one block it changes.
+*
+* Old versions are reclaimed with epoch based reclamation through PolyEpochDomain: a reader announces the epoch it
+* started in, and a retired version is deleted once every reader that could still see it has finished.
+*/
+
+#ifndef SHARED_SPARSE_POLY_
+#define SHARED_SPARSE_POLY_
+
+#include "SparsePolyBase.h"
+#include "SparsePoly.h"
+#include "Node.h"
+#include "PolyKernels.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/** Process wide epochs and reader announcements shared by every SharedSparsePoly. */
+class PolyEpochDomain
+{
+public:
+    /** Number of threads that can be inside a read at the same time. Further readers wait for a slot. */
+    static constexpr size_t SLOT_COUNT = 256;
+
+    /** Value of a slot whose thread is not reading. */
+    static constexpr std::uint64_t IDLE = ~static_cast<std::uint64_t>(0);
+
+    /** Marks the calling thread as reading. Reads may nest; only the outermost one announces an epoch.
+    * @pre None
+    * @post Versions retired from now on are kept until the matching leave. */
+    static void enter();
+
+    /** Marks the end of a read started with enter.
+    * @pre Matches an earlier enter on the same thread.
+    * @post None */
+    static void leave();
+
+    /** Moves to the next epoch. Called by a writer after it has unpublished a version.
+    * @pre None
+    * @post None
+    * @return The epoch that ended, which the unpublished version is retired under. */
+    static std::uint64_t advance();
+
+    /** Checks whether every reader that might have seen a version retired under an epoch has finished.
+    * @pre None
+    * @post None
+    * @param retireEpoch The epoch returned by advance when the version was retired.
+    * @return True if the version can be deleted. */
+    static bool isQuiescent(std::uint64_t retireEpoch);
+
+private:
+    /** One reader announcement, on its own cache line so readers do not contend. */
+    struct alignas(64) Slot
+    {
+        std::atomic<std::uint64_t> epoch;
+        std::atomic<bool> claimed;
+    };
+
+    struct State
+    {
+        std::atomic<std::uint64_t> globalEpoch;
+        Slot slots[SLOT_COUNT];
+
+        State();
+    };
+
+    /** The calling thread's slot, claimed on its first read and released when the thread exits. */
+    struct ThreadSlot
+    {
+        Slot* slot;
+        unsigned int depth;
+
+        ThreadSlot();
+        ~ThreadSlot();
+    };
+
+    /** @return The process wide state. */
+    static State& state();
+
+    /** @return The calling thread's slot. */
+    static ThreadSlot& threadSlot();
+}; // end PolyEpochDomain
+
+/** Scope guard around PolyEpochDomain::enter and leave. */
+class PolyEpochGuard
+{
+public:
+    PolyEpochGuard();
+    ~PolyEpochGuard();
+
+    PolyEpochGuard(const PolyEpochGuard&) = delete;
+    PolyEpochGuard& operator=(const PolyEpochGuard&) = delete;
+}; // end PolyEpochGuard
+
+template <class ItemType>
+class SharedSparsePoly : public SparsePolyBase<SharedSparsePoly<ItemType>, ItemType>
+{
+private:
+
+    /** Target number of terms per block. Blocks split once they hold twice this many. */
+    static constexpr size_t BLOCK_TERMS = 32;
+
+    /** A run of terms sorted from highest to lowest power. Never changed once a version holding it is published. */
+    struct Block
+    {
+        std::vector<Node<ItemType>> terms;
+    };
+
+    /** One published state of the polynomial. Every power in a block is above every power in the blocks after it. */
+    struct Version
+    {
+        std::vector<std::shared_ptr<const Block>> blocks;
+        char variable;
+        int termCount;
+        std::uint64_t number;
+    };
+
+    /** The version readers see. */
+    std::atomic<const Version*> current;
+
+    /** Serialises writers. */
+    std::mutex writerLock;
+
+    /** Unpublished versions with the epoch they were retired under, guarded by writerLock. */
+    std::vector<std::pair<std::uint64_t, const Version*>> retired;
+
+    /** Finds the block that holds, or would hold, a power.
+    * @pre The version has at least one block.
+    * @param version The version to search.
+    * @param power The power to look for.
+    * @return The index of the block. */
+    static size_t findBlock(const Version& version, unsigned int power);
+
+    /** Finds the first term in a block whose power is not greater than the given power.
+    * @param block The block to search.
+    * @param power The power to look for.
+    * @return The index of the term with that power, or where it would be inserted. */
+    static size_t findTerm(const Block& block, unsigned int power);
+
+    /** Applies one change to a version that is still being built, copying a shared block the first time it changes.
+    * @pre The version is not published. fresh[i] is true when block i was created for this version.
+    * @post The version holds the change; blocks that grow too large are split and empty blocks are removed.
+    * @param version The version being built.
+    * @param fresh Marks the blocks owned by the version being built.
+    * @param newCoefficient The new coefficient, 0 removes the term.
+    * @param power The power of the term. */
+    static void applyChange(Version& version, std::vector<bool>& fresh, const ItemType& newCoefficient, unsigned int power);
+
+    /** Publishes a version and retires the one it replaces.
+    * @pre writerLock is held.
+    * @post Readers that start from now on see the new version. */
+    void publish(const Version* next);
+
+    /** Deletes retired versions that no reader can still see.
+    * @pre writerLock is held. */
+    void reclaimRetired();
+
+    /** Calls visit(coefficient, power) for each term of a version from the highest to the lowest power. */
+    template <class Visitor>
+    static void visitTerms(const Version& version, Visitor&& visit);
+
+public:
+
+    /** Default constructor that uses 'x' as the variable.
+    * @pre None
+    * @post The published version is empty. */
+    SharedSparsePoly();
+
+    /** Constructor that allows a custom variable character.
+    * @pre None
+    * @post The published version is empty. */
+    SharedSparsePoly(char var);
+
+    /** Constructor that publishes the terms and variable of a polynomial.
+    * @pre None
+    * @post None
+    * @param initial The polynomial to start from. */
+    explicit SharedSparsePoly(const SparsePoly<ItemType>& initial);
+
+    SharedSparsePoly(const SharedSparsePoly&) = delete;
+    SharedSparsePoly& operator=(const SharedSparsePoly&) = delete;
+
+    /** Publishes a version with one coefficient changed. A 0 coefficient removes the term.
+    * @pre None
+    * @post Readers that start after the call see the change; readers already running keep the version they started with.
+    * @param newCoefficient This is the new coefficient to update, add, or delete.
+    * @param power Is the power of the target term.
+    * @return Will return 0 if the update was completed successfully. */
+    int changeCoefficient(ItemType newCoefficient, unsigned int power);
+
+    /** Publishes a version with several coefficients changed at once, so readers see either none or all of them.
+    * @pre None
+    * @post As for changeCoefficient, applied in order.
+    * @param changes The new coefficients and their powers. */
+    void changeCoefficients(const std::vector<Node<ItemType>>& changes);
+
+    /** Publishes the terms of a polynomial, replacing every term and the variable.
+    * @pre None
+    * @post Readers that start after the call see the new terms.
+    * @param somePoly The polynomial to publish. */
+    void assign(const SparsePoly<ItemType>& somePoly);
+
+    /** Publishes an empty version.
+    * @pre None
+    * @post Readers that start after the call see no terms. */
+    void clear();
+
+    /** Retrieves the degree of the current version.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return Returns the degree of the polynomial or -1 if the polynomial is empty. */
+    unsigned int degree() const;
+
+    /** Returns the coefficient of a term in the current version.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param power The power of the target term.
+    * @return The coefficient, or 0 if there is no such term. */
+    ItemType coefficient(unsigned int power) const;
+
+    /** Displays the current version in the same format as SparsePoly.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A string of the polynomial, or '0' if the polynomial is empty. */
+    std::string displayPoly() const;
+
+    /** Checks if the current version contains terms.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return True if the polynomial has no terms. */
+    bool isEmpty() const;
+
+    /** @return The variable character of the current version. */
+    char getVariable() const;
+
+    /** @return The number of terms in the current version. */
+    int getTermCount() const;
+
+    /** @return How many versions have been published since construction; the first version is 0. */
+    std::uint64_t getVersion() const;
+
+    /** Visits every term of one version from the highest to the lowest power. Updates published while the visit runs are not seen.
+    * @pre The visitor must not update this polynomial.
+    * @post Does not change the polynomial.
+    * @param visit Callable invoked as visit(coefficient, power) for each term. */
+    template <class Visitor>
+    void forEachTerm(Visitor&& visit) const;
+
+    /** Evaluates the current version at a given value of the variable without taking a lock.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param x The value given for the variable.
+    * @return The result of evaluating the polynomial at that value. */
+    ItemType evaluate(ItemType x) const;
+
+    /** Copies the current version into a SparsePoly.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A polynomial with the terms and variable of one consistent version. */
+    SparsePoly<ItemType> toSparsePoly() const;
+
+    /** Destructor that frees every version.
+    * @pre No thread is still reading the polynomial.
+    * @post None */
+    ~SharedSparsePoly();
+}; // end SharedSparsePoly
+
+#include "SharedSparsePoly.cpp"
+#endif
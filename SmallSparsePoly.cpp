@@ -0,0 +1,471 @@
+/** @file SmallSparsePoly.cpp
+* SmallSparsePoly keeps a sparse polynomial in a sorted term array that lives inside the object until it outgrows it.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "SmallSparsePoly.h"
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+template <class ItemType, size_t InlineTerms>
+typename SmallSparsePoly<ItemType, InlineTerms>::Term* SmallSparsePoly<ItemType, InlineTerms>::data()
+{
+    return (heapTerms != nullptr) ? heapTerms : inlineTerms;
+}  // End data
+
+template <class ItemType, size_t InlineTerms>
+const typename SmallSparsePoly<ItemType, InlineTerms>::Term* SmallSparsePoly<ItemType, InlineTerms>::data() const
+{
+    return (heapTerms != nullptr) ? heapTerms : inlineTerms;
+}  // End data
+
+// Binary search over powers sorted from highest to lowest
+template <class ItemType, size_t InlineTerms>
+size_t SmallSparsePoly<ItemType, InlineTerms>::findIndex(unsigned int power) const
+{
+    const Term* terms = data();
+    size_t low = 0;
+    size_t high = termCount;
+    while (low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (terms[middle].power > power)
+        {
+            low = middle + 1;
+        }
+        else
+        {
+            high = middle;
+        } // End if
+    } // End while
+    return low;
+}  // End findIndex
+
+// Moves the terms to a larger heap array when they no longer fit
+template <class ItemType, size_t InlineTerms>
+void SmallSparsePoly<ItemType, InlineTerms>::reserve(size_t count)
+{
+    const size_t capacity = (heapTerms != nullptr) ? heapCapacity : InlineTerms;
+    if (count <= capacity)
+    {
+        return;
+    } // End if
+    size_t newCapacity = std::max(count, 2 * capacity);
+    Term* newTerms = new Term[newCapacity];
+    POLY_INSTRUMENT_ALLOCATE(newCapacity, newCapacity * sizeof(Term));
+    std::copy(data(), data() + termCount, newTerms);
+    if (heapTerms != nullptr)
+    {
+        delete[] heapTerms;
+        POLY_INSTRUMENT_FREE(heapCapacity, heapCapacity * sizeof(Term));
+    } // End if
+    heapTerms = newTerms;
+    heapCapacity = newCapacity;
+}  // End reserve
+
+template <class ItemType, size_t InlineTerms>
+void SmallSparsePoly<ItemType, InlineTerms>::appendTerm(const ItemType& coefficient, unsigned int power)
+{
+    Term& term = data()[termCount];
+    term.coefficient = coefficient;
+    term.power = power;
+    termCount++;
+}  // End appendTerm
+
+template <class ItemType, size_t InlineTerms>
+void SmallSparsePoly<ItemType, InlineTerms>::releaseHeap()
+{
+    if (heapTerms != nullptr)
+    {
+        delete[] heapTerms;
+        POLY_INSTRUMENT_FREE(heapCapacity, heapCapacity * sizeof(Term));
+        heapTerms = nullptr;
+        heapCapacity = 0;
+    } // End if
+    termCount = 0;
+}  // End releaseHeap
+
+// Copies only as much storage as the other polynomial uses
+template <class ItemType, size_t InlineTerms>
+void SmallSparsePoly<ItemType, InlineTerms>::copyFrom(const SmallSparsePoly& other)
+{
+    variable = other.variable;
+    reserve(other.termCount);
+    std::copy(other.data(), other.data() + other.termCount, data());
+    termCount = other.termCount;
+}  // End copyFrom
+
+// Steals a heap array outright; inline terms are copied as one block
+template <class ItemType, size_t InlineTerms>
+void SmallSparsePoly<ItemType, InlineTerms>::moveFrom(SmallSparsePoly& other) noexcept
+{
+    variable = other.variable;
+    if (other.heapTerms != nullptr)
+    {
+        heapTerms = other.heapTerms;
+        heapCapacity = other.heapCapacity;
+        other.heapTerms = nullptr;
+        other.heapCapacity = 0;
+    }
+    else
+    {
+        std::copy(other.inlineTerms, other.inlineTerms + other.termCount, inlineTerms);
+    } // End if
+    termCount = other.termCount;
+    other.termCount = 0;
+}  // End moveFrom
+
+// Default constructor
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>::SmallSparsePoly() : heapTerms(nullptr), heapCapacity(0), termCount(0), variable('x')
+{ }  // End default constructor
+
+// Constructor allowing custom variable character
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>::SmallSparsePoly(char var) : heapTerms(nullptr), heapCapacity(0), termCount(0), variable(var)
+{ }  // End variable constructor
+
+// Copy constructor
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>::SmallSparsePoly(const SmallSparsePoly& other) : heapTerms(nullptr), heapCapacity(0), termCount(0), variable('x')
+{
+    POLY_INSTRUMENT_OPERATION(Copy);
+    copyFrom(other);
+}  // End copy constructor
+
+// Move constructor
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>::SmallSparsePoly(SmallSparsePoly&& other) noexcept : heapTerms(nullptr), heapCapacity(0), termCount(0), variable('x')
+{
+    moveFrom(other);
+}  // End move constructor
+
+// Conversion from the linked list polynomial, whose terms already arrive sorted
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>::SmallSparsePoly(const SparsePoly<ItemType>& other) : heapTerms(nullptr), heapCapacity(0), termCount(0), variable(other.getVariable())
+{
+    reserve(static_cast<size_t>(other.getTermCount()));
+    other.forEachTerm([this](const ItemType& coefficient, unsigned int power)
+    {
+        appendTerm(coefficient, power);
+    });
+}  // End conversion constructor
+
+// Copy assignment operator
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>& SmallSparsePoly<ItemType, InlineTerms>::operator=(const SmallSparsePoly& other)
+{
+    POLY_INSTRUMENT_OPERATION(Copy);
+    if (this != &other)
+    {
+        // Keep a heap array that is already big enough instead of reallocating it
+        termCount = 0;
+        if (heapTerms != nullptr && other.termCount <= InlineTerms)
+        {
+            releaseHeap();
+        } // End if
+        copyFrom(other);
+    } // End if
+    return *this;
+}  // End copy assignment
+
+// Move assignment operator
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>& SmallSparsePoly<ItemType, InlineTerms>::operator=(SmallSparsePoly&& other) noexcept
+{
+    if (this != &other)
+    {
+        releaseHeap();
+        moveFrom(other);
+    } // End if
+    return *this;
+}  // End move assignment
+
+// Updates, inserts or removes the term with the given power
+template <class ItemType, size_t InlineTerms>
+int SmallSparsePoly<ItemType, InlineTerms>::changeCoefficient(ItemType newCoefficient, unsigned int power)
+{
+    POLY_INSTRUMENT_OPERATION(ChangeCoefficient);
+    size_t index = findIndex(power);
+    bool found = index < termCount && data()[index].power == power;
+
+    if (newCoefficient == 0)
+    {
+        if (found)
+        {
+            // Close the gap; heap storage is kept so a polynomial hovering at the limit does not reallocate
+            Term* terms = data();
+            std::copy(terms + index + 1, terms + termCount, terms + index);
+            termCount--;
+        } // End if
+        return 0;
+    } // End if
+
+    if (found)
+    {
+        data()[index].coefficient = newCoefficient;
+        return 0;
+    } // End if
+
+    reserve(termCount + 1);
+    Term* terms = data();
+    std::copy_backward(terms + index, terms + termCount, terms + termCount + 1);
+    terms[index].coefficient = newCoefficient;
+    terms[index].power = power;
+    termCount++;
+    return 0;
+}  // End changeCoefficient
+
+template <class ItemType, size_t InlineTerms>
+void SmallSparsePoly<ItemType, InlineTerms>::clear()
+{
+    POLY_INSTRUMENT_OPERATION(Clear);
+    releaseHeap();
+}  // End clear
+
+// Returns the degree of the polynomial
+template <class ItemType, size_t InlineTerms>
+unsigned int SmallSparsePoly<ItemType, InlineTerms>::degree() const
+{
+    POLY_INSTRUMENT_OPERATION(Degree);
+    if (termCount == 0)
+    {
+        return -1; // Polynomial is empty
+    } // End if
+    return data()[0].power;
+}  // End degree
+
+template <class ItemType, size_t InlineTerms>
+ItemType SmallSparsePoly<ItemType, InlineTerms>::coefficient(unsigned int power) const
+{
+    POLY_INSTRUMENT_OPERATION(Coefficient);
+    size_t index = findIndex(power);
+    if (index < termCount && data()[index].power == power)
+    {
+        return data()[index].coefficient;
+    } // End if
+    return 0;
+}  // End coefficient
+
+template <class ItemType, size_t InlineTerms>
+std::string SmallSparsePoly<ItemType, InlineTerms>::displayPoly() const
+{
+    POLY_INSTRUMENT_OPERATION(DisplayPoly);
+    return this->formatTerms(variable);
+}  // End displayPoly
+
+template <class ItemType, size_t InlineTerms>
+bool SmallSparsePoly<ItemType, InlineTerms>::isEmpty() const
+{
+    return termCount == 0;
+}  // End isEmpty
+
+template <class ItemType, size_t InlineTerms>
+char SmallSparsePoly<ItemType, InlineTerms>::getVariable() const
+{
+    return variable;
+}  // End getVariable
+
+template <class ItemType, size_t InlineTerms>
+int SmallSparsePoly<ItemType, InlineTerms>::getTermCount() const
+{
+    return static_cast<int>(termCount);
+}  // End getTermCount
+
+template <class ItemType, size_t InlineTerms>
+bool SmallSparsePoly<ItemType, InlineTerms>::isInline() const
+{
+    return heapTerms == nullptr;
+}  // End isInline
+
+template <class ItemType, size_t InlineTerms>
+PolyFootprint SmallSparsePoly<ItemType, InlineTerms>::memoryFootprint() const
+{
+    if (heapTerms == nullptr)
+    {
+        return PolyFootprint(sizeof(SmallSparsePoly), 0, 0);
+    } // End if
+    return PolyFootprint(sizeof(SmallSparsePoly), heapCapacity * sizeof(Term), 1);
+}  // End memoryFootprint
+
+template <class ItemType, size_t InlineTerms>
+template <class Visitor>
+void SmallSparsePoly<ItemType, InlineTerms>::forEachTerm(Visitor&& visit) const
+{
+    const Term* terms = data();
+    for (size_t i = 0; i < termCount; i++)
+    {
+        visit(terms[i].coefficient, terms[i].power);
+    } // End for
+}  // End forEachTerm
+
+// Counts the merged terms, then merges the two sorted term arrays straight into the result's storage
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms> SmallSparsePoly<ItemType, InlineTerms>::add(const SmallSparsePoly& anotherPoly) const
+{
+    POLY_INSTRUMENT_OPERATION(Add);
+    SmallSparsePoly result(variable);
+    if (variable != anotherPoly.variable)
+    {
+        return SmallSparsePoly();
+    } // End if
+
+    const Term* thisTerms = data();
+    const Term* otherTerms = anotherPoly.data();
+    size_t i = 0;
+    size_t j = 0;
+
+    // Sizing by the merged count rather than the sum of the inputs keeps a result that fits inline off the heap
+    size_t mergedCount = 0;
+    while (i < termCount && j < anotherPoly.termCount)
+    {
+        if (thisTerms[i].power == otherTerms[j].power)
+        {
+            mergedCount += (thisTerms[i].coefficient + otherTerms[j].coefficient != 0) ? 1 : 0;
+            i++;
+            j++;
+        }
+        else if (thisTerms[i].power > otherTerms[j].power)
+        {
+            mergedCount++;
+            i++;
+        }
+        else
+        {
+            mergedCount++;
+            j++;
+        } // End if
+    } // End while
+    result.reserve(mergedCount + (termCount - i) + (anotherPoly.termCount - j));
+
+    i = 0;
+    j = 0;
+    while (i < termCount && j < anotherPoly.termCount)
+    {
+        if (thisTerms[i].power == otherTerms[j].power)
+        {
+            ItemType sum = thisTerms[i].coefficient + otherTerms[j].coefficient;
+            if (sum != 0)
+            {
+                result.appendTerm(sum, thisTerms[i].power);
+            } // End if
+            i++;
+            j++;
+        }
+        else if (thisTerms[i].power > otherTerms[j].power)
+        {
+            result.appendTerm(thisTerms[i].coefficient, thisTerms[i].power);
+            i++;
+        }
+        else
+        {
+            result.appendTerm(otherTerms[j].coefficient, otherTerms[j].power);
+            j++;
+        } // End if
+    } // End while
+    for (; i < termCount; i++)
+    {
+        result.appendTerm(thisTerms[i].coefficient, thisTerms[i].power);
+    } // End for
+    for (; j < anotherPoly.termCount; j++)
+    {
+        result.appendTerm(otherTerms[j].coefficient, otherTerms[j].power);
+    } // End for
+    return result;
+}  // End add
+
+// Multiplies every pair of terms, then sorts and combines equal powers
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms> SmallSparsePoly<ItemType, InlineTerms>::multiply(const SmallSparsePoly& anotherPoly) const
+{
+    POLY_INSTRUMENT_OPERATION(Multiply);
+    SmallSparsePoly result(variable);
+    if (variable != anotherPoly.variable)
+    {
+        return SmallSparsePoly();
+    } // End if
+
+    const Term* thisTerms = data();
+    const Term* otherTerms = anotherPoly.data();
+    TermAccumulator<ItemType> pairs;
+    for (size_t i = 0; i < termCount; i++)
+    {
+        for (size_t j = 0; j < anotherPoly.termCount; j++)
+        {
+            pairs.push(thisTerms[i].coefficient * otherTerms[j].coefficient, thisTerms[i].power + otherTerms[j].power);
+        } // End for
+    } // End for
+
+    std::vector<Node<ItemType>> product;
+    pairs.finish(product);
+    result.reserve(product.size());
+    for (const Node<ItemType>& term : product)
+    {
+        result.appendTerm(term.getCoefficient(), term.getPower());
+    } // End for
+    return result;
+}  // End multiply
+
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms> SmallSparsePoly<ItemType, InlineTerms>::scalarMultiply(ItemType scalar) const
+{
+    POLY_INSTRUMENT_OPERATION(ScalarMultiply);
+    SmallSparsePoly result(variable);
+    if (scalar == 0)
+    {
+        return result;
+    } // End if
+    result.reserve(termCount);
+    const Term* terms = data();
+    for (size_t i = 0; i < termCount; i++)
+    {
+        ItemType product = terms[i].coefficient * scalar;
+        if (product != 0)
+        {
+            result.appendTerm(product, terms[i].power);
+        } // End if
+    } // End for
+    return result;
+}  // End scalarMultiply
+
+// Horner's rule over the sorted terms: each step multiplies by x raised to the gap down to the next power
+template <class ItemType, size_t InlineTerms>
+ItemType SmallSparsePoly<ItemType, InlineTerms>::evaluate(ItemType x) const
+{
+    POLY_INSTRUMENT_OPERATION(Evaluate);
+    if (termCount == 0)
+    {
+        return 0;
+    } // End if
+    const Term* terms = data();
+    ItemType result = terms[0].coefficient;
+    for (size_t i = 1; i < termCount; i++)
+    {
+        result = result * PolyKernels<ItemType>::power(x, terms[i - 1].power - terms[i].power) + terms[i].coefficient;
+    } // End for
+    return result * PolyKernels<ItemType>::power(x, terms[termCount - 1].power);
+}  // End evaluate
+
+template <class ItemType, size_t InlineTerms>
+SparsePoly<ItemType> SmallSparsePoly<ItemType, InlineTerms>::toSparsePoly() const
+{
+    SparsePoly<ItemType> result(variable);
+    std::vector<Node<ItemType>> terms;
+    terms.reserve(termCount);
+    forEachTerm([&terms](const ItemType& coefficient, unsigned int power)
+    {
+        terms.push_back(Node<ItemType>(coefficient, power));
+    });
+    result.assignTerms(terms);
+    return result;
+}  // End toSparsePoly
+
+// Destructor
+template <class ItemType, size_t InlineTerms>
+SmallSparsePoly<ItemType, InlineTerms>::~SmallSparsePoly()
+{
+    releaseHeap();
+}  // End destructor
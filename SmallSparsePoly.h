@@ -0,0 +1,244 @@
+/** @file SmallSparsePoly.h
+* @class SmallSparsePoly
+* Sparse polynomial backend with small-buffer storage. Up to InlineTerms terms are kept in an array inside the object, so
+* small polynomials need no heap memory and copying one is a single block copy. Once the polynomial outgrows the array
+* its terms move to a heap array, which then grows by doubling. Terms are stored contiguously and ordered by power from
+* highest to lowest, so evaluate and add run straight over the arrays. Plugs into SparsePolyBase like SparsePoly and
+* converts to and from it.
+*/
+
+#ifndef SMALL_SPARSE_POLY_
+#define SMALL_SPARSE_POLY_
+
+#include "SparsePolyBase.h"
+#include "SparsePoly.h"
+#include "PolyExpr.h"
+#include "PolyKernels.h"
+#include "PolyInstrumentation.h"
+#include "PolyFootprint.h"
+#include <cstddef>
+#include <string>
+
+template <class ItemType, size_t InlineTerms = 8>
+class SmallSparsePoly : public SparsePolyBase<SmallSparsePoly<ItemType, InlineTerms>, ItemType>
+{
+    static_assert(InlineTerms > 0, "SmallSparsePoly needs room for at least one inline term");
+
+private:
+
+    /** One stored term. */
+    struct Term
+    {
+        ItemType coefficient;
+        unsigned int power;
+    };
+
+    /** Inline storage used while the polynomial has at most InlineTerms terms. */
+    Term inlineTerms[InlineTerms];
+
+    /** Heap storage once the polynomial has outgrown the inline array, otherwise nullptr. */
+    Term* heapTerms;
+
+    /** Number of terms the heap array can hold. */
+    size_t heapCapacity;
+
+    /** Number of terms currently stored. */
+    size_t termCount;
+
+    /** Character for polynomial variable, default is 'x'. */
+    char variable;
+
+    /** @return The array holding the terms, inline or on the heap. */
+    Term* data();
+
+    /** @return The array holding the terms, inline or on the heap. */
+    const Term* data() const;
+
+    /** Finds the index of the first term whose power is not greater than the given power.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param power The power to look for.
+    * @return The index of the term with that power, or the index where it would be inserted. */
+    size_t findIndex(unsigned int power) const;
+
+    /** Makes sure the storage can hold a number of terms, moving to (or growing) the heap array if needed.
+    * @pre None
+    * @post The storage holds the same terms and has room for at least count terms.
+    * @param count The number of terms needed. */
+    void reserve(size_t count);
+
+    /** Appends a term after the current lowest power term.
+    * @pre There is room for one more term and power is below every stored power.
+    * @post The term is the last term of the polynomial.
+    * @param coefficient The coefficient of the new term.
+    * @param power The power of the new term. */
+    void appendTerm(const ItemType& coefficient, unsigned int power);
+
+    /** Returns heap storage, if any, and goes back to the inline array.
+    * @pre None
+    * @post The polynomial is empty and uses inline storage. */
+    void releaseHeap();
+
+    /** Copies the terms and variable of another polynomial into this empty polynomial.
+    * @pre The polynomial is empty and uses inline storage.
+    * @post The polynomial holds a copy of the other polynomial. */
+    void copyFrom(const SmallSparsePoly& other);
+
+    /** Takes the terms and variable of another polynomial, stealing its heap array if it has one.
+    * @pre The polynomial is empty and uses inline storage.
+    * @post The other polynomial is left empty. */
+    void moveFrom(SmallSparsePoly& other) noexcept;
+
+public:
+
+    /** Default constructor that uses 'x' as the variable.
+    * @pre None
+    * @post None */
+    SmallSparsePoly();
+
+    /** Constructor that allows a custom variable character.
+    * @pre None
+    * @post None */
+    SmallSparsePoly(char var);
+
+    /** Copy constructor. Copies only the array block when the terms are inline.
+    * @pre None
+    * @post None */
+    SmallSparsePoly(const SmallSparsePoly& other);
+
+    /** Move constructor. Steals the heap array if there is one, otherwise copies the inline block.
+    * @pre None
+    * @post The other polynomial is left empty. */
+    SmallSparsePoly(SmallSparsePoly&& other) noexcept;
+
+    /** Constructor that copies the terms and variable of a linked list polynomial.
+    * @pre None
+    * @post None
+    * @param other The polynomial to copy. */
+    explicit SmallSparsePoly(const SparsePoly<ItemType>& other);
+
+    /** Copy assignment operator.
+    * @pre None
+    * @post The polynomial holds a copy of the other polynomial's terms and variable.
+    * @param other The polynomial to copy.
+    * @return A reference to this polynomial. */
+    SmallSparsePoly& operator=(const SmallSparsePoly& other);
+
+    /** Move assignment operator.
+    * @pre None
+    * @post The other polynomial is left empty.
+    * @param other The polynomial to move from.
+    * @return A reference to this polynomial. */
+    SmallSparsePoly& operator=(SmallSparsePoly&& other) noexcept;
+
+    /** Updates a coefficient in the term of a given power. A 0 coefficient removes the term, a new power is inserted in sorted position and an existing power is overwritten.
+    * @pre Only nonnegative powers are accepted.
+    * @post The term is updated, removed or added. The storage moves to the heap if the inline array is full.
+    * @param newCoefficient This is the new coefficient to update, add, or delete.
+    * @param power Is the power of the target term.
+    * @return Will return 0 if the update was completed successfully. */
+    int changeCoefficient(ItemType newCoefficient, unsigned int power);
+
+    /** Clears the polynomial, returning any heap storage.
+    * @pre None
+    * @post The polynomial is empty and uses inline storage. */
+    void clear();
+
+    /** Retrieves the degree of the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return Returns the degree of the polynomial or -1 if the polynomial is empty. */
+    unsigned int degree() const;
+
+    /** Returns the coefficient in the term of a given power.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @param power The power of the target term.
+    * @return The coefficient of the indicated term or 0 if there is no such term. */
+    ItemType coefficient(unsigned int power) const;
+
+    /** Displays the polynomial in the same format as SparsePoly.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A string of the polynomial, or '0' if the polynomial is empty. */
+    std::string displayPoly() const;
+
+    /** Checks if polynomial contains terms.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return True if the polynomial has no terms. */
+    bool isEmpty() const;
+
+    /** Retrieves the variable character of the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The variable character. */
+    char getVariable() const;
+
+    /** Retrieves the number of terms in the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The number of nonzero terms. */
+    int getTermCount() const;
+
+    /** Checks whether the terms are held in the inline array.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return True if no heap storage is in use. */
+    bool isInline() const;
+
+    /** Reports the memory used by the polynomial: the object, which holds the inline array, and the heap array if there is one.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The footprint; the heap bytes count the whole capacity of the heap array. */
+    PolyFootprint memoryFootprint() const;
+
+    /** Visits every term from the highest to the lowest power.
+    * @pre The visitor must not modify the polynomial.
+    * @post Does not change the polynomial.
+    * @param visit Callable invoked as visit(coefficient, power) for each term. */
+    template <class Visitor>
+    void forEachTerm(Visitor&& visit) const;
+
+    /** Adds another polynomial to this polynomial by merging the two term arrays.
+    * @pre Both polynomials contain the same variable.
+    * @post Does not change the original polynomial.
+    * @param anotherPoly Is the other polynomial.
+    * @return A new polynomial resulting from addition. Will return an empty polynomial if variables do not match. */
+    SmallSparsePoly add(const SmallSparsePoly& anotherPoly) const;
+
+    /** Multiplies another polynomial with this polynomial.
+    * @pre Both polynomials contain the same variable.
+    * @post Does not change the original polynomial.
+    * @param anotherPoly Is the other polynomial.
+    * @return A new polynomial resulting from the multiplication. Will return an empty polynomial if variables do not match. */
+    SmallSparsePoly multiply(const SmallSparsePoly& anotherPoly) const;
+
+    /** Multiplies the polynomial by a scalar.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param scalar The value multiplied with the polynomial.
+    * @return A new polynomial resulting from multiplying the scalar. */
+    SmallSparsePoly scalarMultiply(ItemType scalar) const;
+
+    /** Evaluates the polynomial at a given value of the variable with Horner's rule, raising x only across gaps between powers.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param x The value given for the variable.
+    * @return The result of evaluating the polynomial at that value. */
+    ItemType evaluate(ItemType x) const;
+
+    /** Copies the polynomial into a linked list polynomial.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @return A SparsePoly with the same terms and variable. */
+    SparsePoly<ItemType> toSparsePoly() const;
+
+    /** Destructor
+    * @pre None
+    * @post None */
+    ~SmallSparsePoly();
+}; // end SmallSparsePoly
+
+#include "SmallSparsePoly.cpp"
+#endif
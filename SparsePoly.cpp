@@ -7,26 +7,31 @@
 
 #include "SparsePoly.h"
 #include "Node.h"
+#include <algorithm>
 #include <cstddef>
 #include <vector>
 #include <cmath>
+#include <limits>
+#include <utility>
 
 // Default constructor
 template <class ItemType>
-SparsePoly<ItemType>::SparsePoly() : headPtr(nullptr), termCount(0), variable('x')
+SparsePoly<ItemType>::SparsePoly() : headPtr(nullptr), termCount(0), variable('x'), termHash(0)
 { }  // End default constructor
 
 // Constructor allowing custom variable character
 template <class ItemType>
-SparsePoly<ItemType>::SparsePoly(char var) : headPtr(nullptr), termCount(0), variable(var)
+SparsePoly<ItemType>::SparsePoly(char var) : headPtr(nullptr), termCount(0), variable(var), termHash(0)
 { }  // End variable constructor
 
 // Copy constructor
 template <class ItemType>
 SparsePoly<ItemType>::SparsePoly(const SparsePoly<ItemType>& other)
 {
+    POLY_INSTRUMENT_OPERATION(Copy);
     termCount = other.termCount;
     variable = other.variable;
+    termHash = other.termHash;
     Node<ItemType>* origChainPtr = other.headPtr; // Points to nodes in original chain
 
     if (origChainPtr == nullptr)
@@ -35,6 +40,7 @@ SparsePoly<ItemType>::SparsePoly(const SparsePoly<ItemType>& other)
     {
         // Copy first node
         headPtr = new Node<ItemType>(origChainPtr->getCoefficient(), origChainPtr->getPower());
+        POLY_INSTRUMENT_ALLOCATE(1, sizeof(Node<ItemType>));
 
         // Copy remaining nodes
         Node<ItemType>* endChainPtr = headPtr; // Points to last node in new chain
@@ -42,12 +48,14 @@ SparsePoly<ItemType>::SparsePoly(const SparsePoly<ItemType>& other)
 
         while (origChainPtr != nullptr)
         {
+            POLY_INSTRUMENT_TRAVERSE(1);
             // Get next items from original chain
             ItemType nextCoefficient = origChainPtr->getCoefficient();
             unsigned int nextPower = origChainPtr->getPower();
 
             // Create a new node containing the next coefficient and power
             Node<ItemType>* newNode = new Node<ItemType>(nextCoefficient, nextPower);
+            POLY_INSTRUMENT_ALLOCATE(1, sizeof(Node<ItemType>));
 
             // Link new node to end of new chain
             endChainPtr->setNext(newNode);
@@ -63,10 +71,81 @@ SparsePoly<ItemType>::SparsePoly(const SparsePoly<ItemType>& other)
     } // End if
 }  // End copy constructor
 
+// Move constructor
+template <class ItemType>
+SparsePoly<ItemType>::SparsePoly(SparsePoly<ItemType>&& other) noexcept
+    : headPtr(other.headPtr), variable(other.variable), termCount(other.termCount), termHash(other.termHash)
+{
+    // Leave the other polynomial as a valid empty polynomial
+    other.headPtr = nullptr;
+    other.termCount = 0;
+    other.termHash = 0;
+}  // End move constructor
+
+// Constructor evaluating a lazy expression
+template <class ItemType>
+template <class Expr>
+SparsePoly<ItemType>::SparsePoly(const PolyExpr<Expr>& expr) : headPtr(nullptr), variable('x'), termCount(0), termHash(0)
+{
+    *this = expr;
+}  // End expression constructor
+
+// Copy assignment operator
+template <class ItemType>
+SparsePoly<ItemType>& SparsePoly<ItemType>::operator=(const SparsePoly<ItemType>& other)
+{
+    if (this != &other)
+    {
+        SparsePoly<ItemType> copy(other); // Deep copy before releasing current terms
+        *this = std::move(copy);
+    } // End if
+    return *this;
+}  // End copy assignment
+
+// Move assignment operator
+template <class ItemType>
+SparsePoly<ItemType>& SparsePoly<ItemType>::operator=(SparsePoly<ItemType>&& other) noexcept
+{
+    if (this != &other)
+    {
+        clear();
+        headPtr = other.headPtr;
+        variable = other.variable;
+        termCount = other.termCount;
+        termHash = other.termHash;
+        other.headPtr = nullptr;
+        other.termCount = 0;
+        other.termHash = 0;
+    } // End if
+    return *this;
+}  // End move assignment
+
+// Assigns the result of a lazy expression
+template <class ItemType>
+template <class Expr>
+SparsePoly<ItemType>& SparsePoly<ItemType>::operator=(const PolyExpr<Expr>& expr)
+{
+    POLY_INSTRUMENT_OPERATION(ExpressionAssign);
+    const Expr& root = expr.self();
+    std::vector<Node<ItemType>> terms;
+
+    // Collect every term of the expression before touching this polynomial, so the expression may refer to it
+    if (root.isValid())
+    {
+        TermAccumulator<ItemType> accumulator;
+        root.emitTerms(static_cast<ItemType>(1), accumulator);
+        accumulator.finish(terms);
+    } // End if
+    variable = root.getVariable();
+    assignTerms(terms);
+    return *this;
+}  // End expression assignment
+
 // Returns the degree of the polynomial
 template <class ItemType>
 unsigned int SparsePoly<ItemType>::degree() const 
 {
+    POLY_INSTRUMENT_OPERATION(Degree);
     if (headPtr == nullptr) 
     {
         return -1; // Polymonial is empty
@@ -78,6 +157,7 @@ unsigned int SparsePoly<ItemType>::degree() const
 template <class ItemType>
 ItemType SparsePoly<ItemType>::coefficient(unsigned int power) const 
 {
+    POLY_INSTRUMENT_OPERATION(Coefficient);
     Node<ItemType>* nodePtr = getPointerTo(power); // Use getPointerTo to find the correct pointer
     if (nodePtr != nullptr) 
     {
@@ -92,6 +172,7 @@ ItemType SparsePoly<ItemType>::coefficient(unsigned int power) const
 template <class ItemType>
 int SparsePoly<ItemType>::changeCoefficient(ItemType newCoefficient, unsigned int power) 
 {
+    POLY_INSTRUMENT_OPERATION(ChangeCoefficient);
     if (power < 0) // Checking if power is nonnegative
     {
         return -1;
@@ -109,6 +190,7 @@ int SparsePoly<ItemType>::changeCoefficient(ItemType newCoefficient, unsigned in
     // Traverse to find the correct insertion point
     while (currentPtr != nullptr && currentPtr->getPower() > power) 
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         prevPtr = currentPtr;
         currentPtr = currentPtr->getNext();
     } // End while
@@ -116,12 +198,14 @@ int SparsePoly<ItemType>::changeCoefficient(ItemType newCoefficient, unsigned in
     // If a term with the same power is found, update its coefficient
     if (currentPtr != nullptr && currentPtr->getPower() == power) 
     {
+        termHash += hashTerm(newCoefficient, power) - hashTerm(currentPtr->getCoefficient(), power);
         currentPtr->setCoefficient(newCoefficient);
     }
     else 
     {
         // Create a new node for the new term
         Node<ItemType>* newNode = new Node<ItemType>(newCoefficient, power);
+        POLY_INSTRUMENT_ALLOCATE(1, sizeof(Node<ItemType>));
         newNode->setNext(nullptr);
 
         // Insert in the correct sorted position
@@ -137,6 +221,7 @@ int SparsePoly<ItemType>::changeCoefficient(ItemType newCoefficient, unsigned in
             prevPtr->setNext(newNode);
         } // End if
         termCount++;
+        termHash += hashTerm(newCoefficient, power);
         newNode = nullptr;
     } // End if
     prevPtr = nullptr;
@@ -154,6 +239,7 @@ std::vector<Node<ItemType>> SparsePoly<ItemType>::toVector() const
     int counter = 0;
     while ((currentPtr != nullptr) && (counter < termCount))
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         // Copy coefficient and power from each node into vector
         polyContents.push_back(Node<ItemType>(currentPtr->getCoefficient(), currentPtr->getPower()));
         currentPtr = currentPtr->getNext();
@@ -167,6 +253,7 @@ std::vector<Node<ItemType>> SparsePoly<ItemType>::toVector() const
 template <class ItemType>
 void SparsePoly<ItemType>::clear()
 {
+    POLY_INSTRUMENT_OPERATION(Clear);
     Node<ItemType>* currentPtr = headPtr;
     while (currentPtr != nullptr && !isEmpty())
     {
@@ -174,12 +261,14 @@ void SparsePoly<ItemType>::clear()
         currentPtr = currentPtr->getNext();
 
         // Return node to the system
+        POLY_INSTRUMENT_FREE(1, sizeof(Node<ItemType>));
         delete nodeToDelete;
         nodeToDelete = nullptr;
     } // End while
     headPtr = nullptr;
     currentPtr = nullptr;
     termCount = 0;
+    termHash = 0;
 } //End clear
 
 // Helper function to check if the list contains any terms
@@ -189,10 +278,168 @@ bool SparsePoly<ItemType>::isEmpty() const
     return termCount == 0;
 }  // End isEmpty
 
+// Returns the variable character
+template<class ItemType>
+char SparsePoly<ItemType>::getVariable() const
+{
+    return variable;
+}  // End getVariable
+
+// Returns the number of terms
+template<class ItemType>
+int SparsePoly<ItemType>::getTermCount() const
+{
+    return termCount;
+}  // End getTermCount
+
+template<class ItemType>
+PolyFootprint SparsePoly<ItemType>::memoryFootprint() const
+{
+    return PolyFootprint(sizeof(SparsePoly<ItemType>), static_cast<size_t>(termCount) * sizeof(Node<ItemType>), static_cast<size_t>(termCount));
+}  // End memoryFootprint
+
+// Mixes the bits of a 64 bit value (the splitmix64 finalizer)
+template<class ItemType>
+std::uint64_t SparsePoly<ItemType>::mixHash(std::uint64_t value)
+{
+    value ^= value >> 30;
+    value *= 0xBF58476D1CE4E5B9ULL;
+    value ^= value >> 27;
+    value *= 0x94D049BB133111EBULL;
+    value ^= value >> 31;
+    return value;
+}  // End mixHash
+
+// Hashes one term; the polynomial hash is the sum of its term hashes
+template<class ItemType>
+std::uint64_t SparsePoly<ItemType>::hashTerm(const ItemType& coefficient, unsigned int power)
+{
+    const std::uint64_t coefficientHash = static_cast<std::uint64_t>(std::hash<ItemType>()(coefficient));
+    return mixHash(coefficientHash + mixHash(static_cast<std::uint64_t>(power) + 0x9E3779B97F4A7C15ULL));
+}  // End hashTerm
+
+// Returns the hash of the variable and terms
+template<class ItemType>
+std::uint64_t SparsePoly<ItemType>::hash() const
+{
+    return mixHash(termHash ^ static_cast<unsigned char>(variable));
+}  // End hash
+
+// Compares two polynomials term by term, after the cheap checks
+template<class ItemType>
+bool SparsePoly<ItemType>::operator==(const SparsePoly<ItemType>& other) const
+{
+    POLY_INSTRUMENT_OPERATION(Equals);
+    if (variable != other.variable || termCount != other.termCount || termHash != other.termHash)
+    {
+        return false;
+    } // End if
+    if (headPtr != nullptr && headPtr->getPower() != other.headPtr->getPower())
+    {
+        return false; // Different degrees
+    } // End if
+    Node<ItemType>* thisPtr = headPtr;
+    Node<ItemType>* otherPtr = other.headPtr;
+    while (thisPtr != nullptr)
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        if (thisPtr->getPower() != otherPtr->getPower() || !(thisPtr->getCoefficient() == otherPtr->getCoefficient()))
+        {
+            return false;
+        } // End if
+        thisPtr = thisPtr->getNext();
+        otherPtr = otherPtr->getNext();
+    } // End while
+    return true;
+}  // End operator==
+
+// Negation of operator==
+template<class ItemType>
+bool SparsePoly<ItemType>::operator!=(const SparsePoly<ItemType>& other) const
+{
+    return !(*this == other);
+}  // End operator!=
+
+// Visits each term from highest to lowest power
+template<class ItemType>
+template<class Visitor>
+void SparsePoly<ItemType>::forEachTerm(Visitor&& visit) const
+{
+    for (Node<ItemType>* currentPtr = headPtr; currentPtr != nullptr; currentPtr = currentPtr->getNext())
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        visit(currentPtr->getCoefficient(), currentPtr->getPower());
+    } // End for
+}  // End forEachTerm
+
+// Rebuilds the node chain from sorted terms, appending at the tail
+template<class ItemType>
+void SparsePoly<ItemType>::assignTerms(const std::vector<Node<ItemType>>& sortedTerms)
+{
+    POLY_INSTRUMENT_OPERATION(AssignTerms);
+    clear();
+    Node<ItemType>* endChainPtr = nullptr; // Points to last node in new chain
+    for (const Node<ItemType>& term : sortedTerms)
+    {
+        if (term.getCoefficient() == 0)
+        {
+            continue; // Zero terms are never stored
+        } // End if
+        Node<ItemType>* newNode = new Node<ItemType>(term.getCoefficient(), term.getPower());
+        POLY_INSTRUMENT_ALLOCATE(1, sizeof(Node<ItemType>));
+        if (endChainPtr == nullptr)
+        {
+            headPtr = newNode;
+        }
+        else
+        {
+            endChainPtr->setNext(newNode);
+        } // End if
+        endChainPtr = newNode;
+        termCount++;
+        termHash += hashTerm(term.getCoefficient(), term.getPower());
+    } // End for
+    endChainPtr = nullptr;
+}  // End assignTerms
+
+// Copies the polynomial into a dense coefficient vector indexed by power
+template<class ItemType>
+std::vector<ItemType> SparsePoly<ItemType>::toDenseCoefficients() const
+{
+    std::vector<ItemType> coefficients;
+    if (headPtr == nullptr)
+    {
+        return coefficients;
+    } // End if
+    coefficients.assign(static_cast<size_t>(headPtr->getPower()) + 1, static_cast<ItemType>(0));
+    for (Node<ItemType>* currentPtr = headPtr; currentPtr != nullptr; currentPtr = currentPtr->getNext())
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        coefficients[currentPtr->getPower()] = currentPtr->getCoefficient();
+    } // End for
+    return coefficients;
+}  // End toDenseCoefficients
+
+// Rebuilds the polynomial from a dense coefficient vector
+template<class ItemType>
+void SparsePoly<ItemType>::assignDenseCoefficients(const std::vector<ItemType>& coefficients)
+{
+    std::vector<Node<ItemType>> terms;
+    for (size_t i = coefficients.size(); i > 0; i--)
+    {
+        if (coefficients[i - 1] != 0)
+        {
+            terms.push_back(Node<ItemType>(coefficients[i - 1], static_cast<unsigned int>(i - 1)));
+        } // End if
+    } // End for
+    assignTerms(terms);
+}  // End assignDenseCoefficients
+
 // Helper function to remove a term from polynomial
 template <class ItemType>
 bool SparsePoly<ItemType>::removeTerm(const unsigned int power) 
 {
+    POLY_INSTRUMENT_OPERATION(RemoveTerm);
     Node<ItemType>* targetPtr = getPointerTo(power); // Locate pointer to target term
 
     // Check if the polynomial is not empty and the target node exists
@@ -200,6 +447,8 @@ bool SparsePoly<ItemType>::removeTerm(const unsigned int power)
 
     if (canRemoveItem) 
     {
+        termHash -= hashTerm(targetPtr->getCoefficient(), power);
+
         // Removal if the target is the head
         if (targetPtr == headPtr) 
         {
@@ -214,12 +463,14 @@ bool SparsePoly<ItemType>::removeTerm(const unsigned int power)
 
                 // Clean up memory by deleting second node and setting temporary pointer to nullptr
                 nextNodePtr->setNext(nullptr);
+                POLY_INSTRUMENT_FREE(1, sizeof(Node<ItemType>));
                 delete nextNodePtr;
                 nextNodePtr = nullptr;
             }
             else 
             {
                 // If the target term is the only term
+                POLY_INSTRUMENT_FREE(1, sizeof(Node<ItemType>));
                 delete headPtr;
                 headPtr = nullptr;
                 nextNodePtr = nullptr;
@@ -231,12 +482,14 @@ bool SparsePoly<ItemType>::removeTerm(const unsigned int power)
             Node<ItemType>* prevPtr = headPtr;
             while (prevPtr->getNext() != targetPtr) 
             {
+                POLY_INSTRUMENT_TRAVERSE(1);
                 prevPtr = prevPtr->getNext();
             } // End while
             prevPtr->setNext(targetPtr->getNext());
 
             // Clean up memory
             targetPtr->setNext(nullptr);
+            POLY_INSTRUMENT_FREE(1, sizeof(Node<ItemType>));
             delete targetPtr;
             targetPtr = nullptr;
         } // End if
@@ -256,6 +509,7 @@ Node<ItemType>* SparsePoly<ItemType>::getPointerTo(const unsigned int power) con
 
     while (!found && (currentPtr != nullptr))
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         found = (power == currentPtr->getPower());
         if (!found)
         {
@@ -281,6 +535,7 @@ SparsePoly<ItemType>::~SparsePoly()
 template <class ItemType>
 std::string SparsePoly<ItemType>::displayPoly() const
 {
+    POLY_INSTRUMENT_OPERATION(DisplayPoly);
     // Copy polynomial to a vector using the member function toVector()
     std::vector<Node<ItemType>> contents = toVector();
 
@@ -326,11 +581,13 @@ std::string SparsePoly<ItemType>::displayPoly() const
 template <class ItemType>
 ItemType SparsePoly<ItemType>::evaluate(ItemType x) const
 {
+    POLY_INSTRUMENT_OPERATION(Evaluate);
     ItemType result = 0;
     Node<ItemType>* currentPtr = headPtr;
 
     while (currentPtr != nullptr)
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         // Retreive the coefficient and power from each node
         ItemType coefficient = currentPtr->getCoefficient();
         unsigned int power = currentPtr->getPower();
@@ -344,18 +601,146 @@ ItemType SparsePoly<ItemType>::evaluate(ItemType x) const
     return result;
 } // End evaluate
 
+// Evaluates the polynomial and its first k derivatives in one pass
+template <class ItemType>
+std::vector<ItemType> SparsePoly<ItemType>::evaluateDerivatives(ItemType x, unsigned int k) const
+{
+    POLY_INSTRUMENT_OPERATION(EvaluateDerivatives);
+    std::vector<ItemType> results(static_cast<size_t>(k) + 1, static_cast<ItemType>(0));
+    std::vector<ItemType> xPowers(static_cast<size_t>(k) + 1); // xPowers[j] holds x^(power - j) for the current term
+
+    for (Node<ItemType>* currentPtr = headPtr; currentPtr != nullptr; currentPtr = currentPtr->getNext())
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        ItemType coefficient = currentPtr->getCoefficient();
+        unsigned int power = currentPtr->getPower();
+        unsigned int top = (power < k) ? power : k; // Higher derivatives of this term are 0
+
+        // One exponentiation per term, the remaining powers come from repeated multiplication
+        xPowers[top] = PolyKernels<ItemType>::power(x, power - top);
+        for (unsigned int j = top; j > 0; j--)
+        {
+            xPowers[j - 1] = xPowers[j] * x;
+        } // End for
+
+        // The j-th derivative of c * x^n is c * n * (n - 1) * ... * (n - j + 1) * x^(n - j)
+        ItemType factor = coefficient;
+        for (unsigned int j = 0; j <= top; j++)
+        {
+            results[j] += factor * xPowers[j];
+            factor *= static_cast<ItemType>(power - j);
+        } // End for
+    } // End for
+    return results;
+} // End evaluateDerivatives
+
+// Computes the k-th derivative of the polynomial
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::derivative(unsigned int k) const
+{
+    POLY_INSTRUMENT_OPERATION(Derivative);
+    SparsePoly<ItemType> result(variable);
+    std::vector<Node<ItemType>> terms;
+
+    // Terms stay sorted since every power drops by the same amount
+    for (Node<ItemType>* currentPtr = headPtr; currentPtr != nullptr; currentPtr = currentPtr->getNext())
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        unsigned int power = currentPtr->getPower();
+        if (power < k)
+        {
+            break; // All remaining terms have lower powers and vanish
+        } // End if
+        ItemType newCoefficient = currentPtr->getCoefficient();
+        for (unsigned int j = 0; j < k; j++)
+        {
+            newCoefficient *= static_cast<ItemType>(power - j);
+        } // End for
+        terms.push_back(Node<ItemType>(newCoefficient, power - k));
+    } // End for
+    result.assignTerms(terms);
+    return result;
+} // End derivative
+
+// Computes the antiderivative of the polynomial
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::integral() const
+{
+    POLY_INSTRUMENT_OPERATION(Integral);
+    SparsePoly<ItemType> result(variable);
+    if (headPtr != nullptr && headPtr->getPower() == std::numeric_limits<unsigned int>::max())
+    {
+        return result; // The highest term has no power to integrate to
+    } // End if
+    std::vector<Node<ItemType>> terms;
+    for (Node<ItemType>* currentPtr = headPtr; currentPtr != nullptr; currentPtr = currentPtr->getNext())
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        unsigned int newPower = currentPtr->getPower() + 1;
+        terms.push_back(Node<ItemType>(currentPtr->getCoefficient() / static_cast<ItemType>(newPower), newPower));
+    } // End for
+    result.assignTerms(terms);
+    return result;
+} // End integral
+
+// Computes p(x + a)
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::taylorShift(ItemType a) const
+{
+    POLY_INSTRUMENT_OPERATION(TaylorShift);
+    SparsePoly<ItemType> result(variable);
+    if (headPtr == nullptr)
+    {
+        return result;
+    } // End if
+    size_t length = static_cast<size_t>(headPtr->getPower()) + 1;
+
+    if (length < 32 || static_cast<size_t>(termCount) * 8 >= length)
+    {
+        // Small or dense, shift the whole coefficient vector
+        std::vector<ItemType> coefficients = toDenseCoefficients();
+        PolyKernels<ItemType>::taylorShift(coefficients, a);
+        result.assignDenseCoefficients(coefficients);
+        return result;
+    } // End if
+
+    // Sparse, expand c * (x + a)^n = c * sum C(n, j) * a^(n - j) * x^j for each term
+    std::vector<ItemType> coefficients(length, static_cast<ItemType>(0));
+    for (Node<ItemType>* currentPtr = headPtr; currentPtr != nullptr; currentPtr = currentPtr->getNext())
+    {
+        POLY_INSTRUMENT_TRAVERSE(1);
+        ItemType coefficient = currentPtr->getCoefficient();
+        unsigned int power = currentPtr->getPower();
+        ItemType binomial = static_cast<ItemType>(1); // C(n, j), starting at j = n
+        ItemType aPower = static_cast<ItemType>(1);   // a^(n - j)
+        for (unsigned int j = power; ; j--)
+        {
+            coefficients[j] += coefficient * binomial * aPower;
+            if (j == 0)
+            {
+                break;
+            } // End if
+            binomial = binomial * static_cast<ItemType>(j) / static_cast<ItemType>(power - j + 1);
+            aPower *= a;
+        } // End for
+    } // End for
+    result.assignDenseCoefficients(coefficients);
+    return result;
+} // End taylorShift
+
 // Adds two polynomials together and returns a new polynomial object
 template <class ItemType>
 SparsePoly<ItemType> SparsePoly<ItemType>::add(const SparsePoly<ItemType>& anotherPoly) const
 {
-    SparsePoly<ItemType> result;
-
+    POLY_INSTRUMENT_OPERATION(Add);
     // Check if variables are the same
     if (variable != anotherPoly.variable)
     {
         // Returns an empty polynomial if their variables to not match
-        return result;
+        return SparsePoly<ItemType>();
     } // End if
+    SparsePoly<ItemType> result(variable);
+
     // Pointer to the current polynomial
     Node<ItemType>* thisPtr = headPtr;
     // Pointer for the other polynomial
@@ -364,6 +749,7 @@ SparsePoly<ItemType> SparsePoly<ItemType>::add(const SparsePoly<ItemType>& anoth
     // Traverse both polynomials
     while (thisPtr != nullptr && otherPtr != nullptr)
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         if (thisPtr->getPower() == otherPtr->getPower())
         {
             // Can add the coefficients
@@ -391,12 +777,14 @@ SparsePoly<ItemType> SparsePoly<ItemType>::add(const SparsePoly<ItemType>& anoth
     // If there are any unused terms in current polynomial
     while (thisPtr != nullptr)
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         result.changeCoefficient(thisPtr->getCoefficient(), thisPtr->getPower());
         thisPtr = thisPtr->getNext();
     } // End while
     // If there are any unused terms in other polynomial
     while (otherPtr != nullptr)
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         result.changeCoefficient(otherPtr->getCoefficient(), otherPtr->getPower());
         otherPtr = otherPtr->getNext();
     } // End while
@@ -405,62 +793,600 @@ SparsePoly<ItemType> SparsePoly<ItemType>::add(const SparsePoly<ItemType>& anoth
     return result;
 } // End add
 
+// Splits sorted terms into runs of consecutive powers
+template <class ItemType>
+void SparsePoly<ItemType>::findRuns(const std::vector<Node<ItemType>>& terms, size_t first,
+    std::vector<TermRun>& runs, std::vector<ItemType>& coefficients)
+{
+    runs.clear();
+    coefficients.clear();
+    size_t start = first;
+    while (start < terms.size())
+    {
+        size_t end = start + 1;
+        while (end < terms.size() && terms[end].getPower() + 1 == terms[end - 1].getPower())
+        {
+            end++;
+        } // End while
+        TermRun run;
+        run.low = terms[end - 1].getPower();
+        run.length = end - start;
+        run.offset = coefficients.size();
+        runs.push_back(run);
+        // The terms run from high to low, the kernel wants the lowest power first
+        for (size_t i = end; i > start; i--)
+        {
+            coefficients.push_back(terms[i - 1].getCoefficient());
+        } // End for
+        start = end;
+    } // End while
+} // End findRuns
+
+// Finds the runs of both operands and reports whether multiplying run by run pays off
+template <class ItemType>
+bool SparsePoly<ItemType>::findRunsIfUseful(const std::vector<Node<ItemType>>& a, size_t firstA,
+    const std::vector<Node<ItemType>>& b, size_t firstB, size_t pairCount, MultiplyBuffers& buffers)
+{
+    findRuns(a, firstA, buffers.runsA, buffers.runCoefficientsA);
+    findRuns(b, firstB, buffers.runsB, buffers.runCoefficientsB);
+    // Worth it once a pair of runs stands for enough pairs of terms to fill a vector row on average
+    return buffers.runsA.size() * buffers.runsB.size() * RUN_KERNEL_LENGTH <= pairCount;
+} // End findRunsIfUseful
+
+// Multiplies every pair of runs, with the dense kernel when both are long enough
+template <class ItemType>
+void SparsePoly<ItemType>::multiplyRuns(MultiplyBuffers& buffers, size_t limit, bool dense)
+{
+    for (const TermRun& runA : buffers.runsA)
+    {
+        for (const TermRun& runB : buffers.runsB)
+        {
+            const size_t base = runA.low + runB.low;
+            if (base >= limit)
+            {
+                continue;
+            } // End if
+            const ItemType* coefficientsA = buffers.runCoefficientsA.data() + runA.offset;
+            const ItemType* coefficientsB = buffers.runCoefficientsB.data() + runB.offset;
+            const size_t top = base + runA.length + runB.length - 1; // One past the highest power of the pair
+            if (runA.length >= RUN_KERNEL_LENGTH && runB.length >= RUN_KERNEL_LENGTH)
+            {
+                ItemType* out;
+                if (dense && top <= limit)
+                {
+                    out = buffers.product.data() + base;
+                }
+                else
+                {
+                    buffers.runProduct.assign(runA.length + runB.length - 1, static_cast<ItemType>(0));
+                    out = buffers.runProduct.data();
+                } // End if
+                PolyKernels<ItemType>::multiplyAccumulate(coefficientsA, runA.length, coefficientsB, runB.length, out);
+                if (out == buffers.runProduct.data())
+                {
+                    // Keep the part of the pair's product below the limit
+                    const size_t kept = std::min(top, limit) - base;
+                    for (size_t k = 0; k < kept; k++)
+                    {
+                        if (dense)
+                        {
+                            buffers.product[base + k] += buffers.runProduct[k];
+                        }
+                        else if (buffers.runProduct[k] != 0)
+                        {
+                            buffers.pairs.push(buffers.runProduct[k], static_cast<unsigned int>(base + k));
+                        } // End if
+                    } // End for
+                } // End if
+            }
+            else
+            {
+                for (size_t i = 0; i < runA.length && base + i < limit; i++)
+                {
+                    for (size_t j = 0; j < runB.length && base + i + j < limit; j++)
+                    {
+                        if (dense)
+                        {
+                            buffers.product[base + i + j] += coefficientsA[i] * coefficientsB[j];
+                        }
+                        else
+                        {
+                            buffers.pairs.push(coefficientsA[i] * coefficientsB[j], static_cast<unsigned int>(base + i + j));
+                        } // End if
+                    } // End for
+                } // End for
+            } // End if
+        } // End for
+    } // End for
+} // End multiplyRuns
+
+// Multiplies two sorted term vectors, choosing a strategy by size and density
+template <class ItemType>
+void SparsePoly<ItemType>::multiplyTerms(const std::vector<Node<ItemType>>& a, const std::vector<Node<ItemType>>& b,
+    std::vector<Node<ItemType>>& product, MultiplyBuffers& buffers, size_t limit)
+{
+    product.clear();
+    // Terms at or above the limit cannot contribute, and they are the leading ones
+    size_t firstA = 0;
+    while (firstA < a.size() && a[firstA].getPower() >= limit)
+    {
+        firstA++;
+    } // End while
+    size_t firstB = 0;
+    while (firstB < b.size() && b[firstB].getPower() >= limit)
+    {
+        firstB++;
+    } // End while
+    if (firstA == a.size() || firstB == b.size())
+    {
+        return;
+    } // End if
+    const size_t countA = a.size() - firstA;
+    const size_t countB = b.size() - firstB;
+    const size_t degreeA = a[firstA].getPower();
+    const size_t degreeB = b[firstB].getPower();
+    const size_t span = std::min(degreeA + degreeB + 1, limit); // Number of powers the product can reach
+    const size_t pairCount = countA * countB;
+
+    if (countA * 4 >= degreeA + 1 && countB * 4 >= degreeB + 1)
+    {
+        // Both operands are dense, scatter them into coefficient arrays and use the Karatsuba kernel
+        buffers.left.assign(degreeA + 1, static_cast<ItemType>(0));
+        buffers.right.assign(degreeB + 1, static_cast<ItemType>(0));
+        for (size_t i = firstA; i < a.size(); i++)
+        {
+            buffers.left[a[i].getPower()] = a[i].getCoefficient();
+        } // End for
+        for (size_t j = firstB; j < b.size(); j++)
+        {
+            buffers.right[b[j].getPower()] = b[j].getCoefficient();
+        } // End for
+        PolyKernels<ItemType>::multiplyTruncatedInto(buffers.left, buffers.right, limit, buffers.product);
+    }
+    else if (span <= 4 * pairCount)
+    {
+        // The product powers are packed closely enough to accumulate every pair straight into a dense array.
+        buffers.product.assign(span, static_cast<ItemType>(0));
+        if (findRunsIfUseful(a, firstA, b, firstB, pairCount, buffers))
+        {
+            multiplyRuns(buffers, limit, true);
+        }
+        else
+        {
+            // Each row walks b from its lowest power up and stops at the limit
+            for (size_t i = firstA; i < a.size(); i++)
+            {
+                const size_t powerA = a[i].getPower();
+                for (size_t j = b.size(); j > firstB && powerA + b[j - 1].getPower() < limit; j--)
+                {
+                    buffers.product[powerA + b[j - 1].getPower()] += a[i].getCoefficient() * b[j - 1].getCoefficient();
+                } // End for
+            } // End for
+        } // End if
+    }
+    else
+    {
+        // Very sparse product, sort the pairwise products and combine equal powers
+        if (findRunsIfUseful(a, firstA, b, firstB, pairCount, buffers))
+        {
+            multiplyRuns(buffers, limit, false);
+        }
+        else
+        {
+            for (size_t i = firstA; i < a.size(); i++)
+            {
+                const size_t powerA = a[i].getPower();
+                for (size_t j = b.size(); j > firstB && powerA + b[j - 1].getPower() < limit; j--)
+                {
+                    buffers.pairs.push(a[i].getCoefficient() * b[j - 1].getCoefficient(), static_cast<unsigned int>(powerA + b[j - 1].getPower()));
+                } // End for
+            } // End for
+        } // End if
+        buffers.pairs.finish(product);
+        return;
+    } // End if
+
+    // Gather the nonzero entries of the dense product from the highest power down
+    for (size_t i = buffers.product.size(); i > 0; i--)
+    {
+        if (buffers.product[i - 1] != 0)
+        {
+            product.push_back(Node<ItemType>(buffers.product[i - 1], static_cast<unsigned int>(i - 1)));
+        } // End if
+    } // End for
+} // End multiplyTerms
+
 // Multiplies two polynomials together and returns a new polynomial object
 template <class ItemType>
 SparsePoly<ItemType> SparsePoly<ItemType>::multiply(const SparsePoly<ItemType>& anotherPoly) const
 {
-    SparsePoly<ItemType> result;
+    POLY_INSTRUMENT_OPERATION(Multiply);
+    SparsePoly<ItemType> result(variable);
 
     // Check if variables are the same
     if (variable != anotherPoly.variable)
     {
         // Returns an empty polynomial if their variables to not match
-        return result;
-    }
-    // Pointer to the current polynomial
-    Node<ItemType>* thisPtr = headPtr;
-    // Pointer for the other polynomial
-    Node<ItemType>* otherPtr = anotherPoly.headPtr;
+        return SparsePoly<ItemType>();
+    } // End if
 
-    if (thisPtr == nullptr || otherPtr == nullptr)
+    std::vector<Node<ItemType>> product;
+    MultiplyBuffers buffers;
+    multiplyTerms(toVector(), anotherPoly.toVector(), product, buffers);
+    result.assignTerms(product);
+    return result;
+} // End multiply
+
+// Raises the polynomial to a power with binary exponentiation
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::pow(unsigned int e) const
+{
+    POLY_INSTRUMENT_OPERATION(Pow);
+    SparsePoly<ItemType> result(variable);
+    std::vector<Node<ItemType>> accumulated(1, Node<ItemType>(static_cast<ItemType>(1), 0));
+    std::vector<Node<ItemType>> base = toVector();
+    std::vector<Node<ItemType>> scratch;
+    MultiplyBuffers buffers;
+
+    while (e > 0)
     {
-        return result;
-    }
-    // Traverse each term of current polynomial
-    while (thisPtr != nullptr)
+        if (e & 1u)
+        {
+            multiplyTerms(accumulated, base, scratch, buffers);
+            accumulated.swap(scratch);
+        } // End if
+        e >>= 1;
+        if (e > 0)
+        {
+            multiplyTerms(base, base, scratch, buffers);
+            base.swap(scratch);
+        } // End if
+    } // End while
+    result.assignTerms(accumulated);
+    return result;
+} // End pow
+
+// Raises the polynomial to a power modulo another polynomial
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::powMod(unsigned int e, const SparsePoly<ItemType>& modulus) const
+{
+    POLY_INSTRUMENT_OPERATION(PowMod);
+    SparsePoly<ItemType> result(variable);
+    if (variable != modulus.variable || modulus.headPtr == nullptr)
+    {
+        return SparsePoly<ItemType>();
+    } // End if
+
+    // Everything stays below the degree of the modulus, so dense buffers of that size are reused for every step
+    std::vector<ItemType> divisor = modulus.toDenseCoefficients();
+    std::vector<ItemType> base = toDenseCoefficients();
+    PolyKernels<ItemType>::remainder(base, divisor);
+    std::vector<ItemType> accumulated(1, static_cast<ItemType>(1));
+    PolyKernels<ItemType>::remainder(accumulated, divisor);
+    std::vector<ItemType> product;
+
+    while (e > 0)
     {
-        // Multiply each term in current polynomial with each term in other polynomial
-        otherPtr = anotherPoly.headPtr; // Reset otherPoly to the first node
-        while (otherPtr != nullptr)
+        if (e & 1u)
         {
-            // Multiply each coefficient and add each power
-            ItemType newCoefficient = thisPtr->getCoefficient() * otherPtr->getCoefficient();
-            unsigned int newPower = thisPtr->getPower() + otherPtr->getPower();
+            PolyKernels<ItemType>::multiplyInto(accumulated, base, product);
+            PolyKernels<ItemType>::remainder(product, divisor);
+            accumulated.swap(product);
+        } // End if
+        e >>= 1;
+        if (e > 0)
+        {
+            PolyKernels<ItemType>::multiplyInto(base, base, product);
+            PolyKernels<ItemType>::remainder(product, divisor);
+            base.swap(product);
+        } // End if
+    } // End while
+    result.assignDenseCoefficients(accumulated);
+    return result;
+} // End powMod
 
-            // Check if coefficient already exists in the result polynomial, if so add the coefficients, if not add a new term
-            ItemType existCoefficient = result.coefficient(newPower);
-            if (existCoefficient != 0)
+// Composes one block of dense coefficients, low(q) + q^half * high(q)
+template <class ItemType>
+void SparsePoly<ItemType>::composeDense(const std::vector<ItemType>& p, size_t offset, unsigned int level,
+    const std::vector<std::vector<ItemType>>& powers, size_t limit, size_t qValuation, std::vector<ItemType>& result)
+{
+    result.clear();
+    // The block ends up multiplied by q^offset, so it cannot reach below offset * qValuation
+    if (offset >= p.size() || (qValuation > 0 && offset >= (limit - 1) / qValuation + 1))
+    {
+        return;
+    } // End if
+    if (level == 0)
+    {
+        if (p[offset] != 0)
+        {
+            result.assign(1, p[offset]);
+        } // End if
+        return;
+    } // End if
+
+    const size_t half = static_cast<size_t>(1) << (level - 1);
+    composeDense(p, offset, level - 1, powers, limit, qValuation, result);
+    std::vector<ItemType> high;
+    composeDense(p, offset + half, level - 1, powers, limit, qValuation, high);
+    if (high.empty() || powers[level - 1].empty())
+    {
+        return;
+    } // End if
+
+    std::vector<ItemType> product;
+    PolyKernels<ItemType>::multiplyTruncatedInto(powers[level - 1], high, limit, product);
+    if (result.size() < product.size())
+    {
+        result.resize(product.size(), static_cast<ItemType>(0));
+    } // End if
+    for (size_t i = 0; i < product.size(); i++)
+    {
+        result[i] += product[i];
+    } // End for
+}  // End composeDense
+
+// Composes one range of sorted terms, recursing only into halves that hold terms
+template <class ItemType>
+void SparsePoly<ItemType>::composeSparse(const std::vector<Node<ItemType>>& p, size_t first, size_t last, size_t low, unsigned int level,
+    const std::vector<std::vector<Node<ItemType>>>& powers, size_t limit, size_t qValuation, MultiplyBuffers& buffers,
+    std::vector<Node<ItemType>>& result)
+{
+    result.clear();
+    if (first == last || (qValuation > 0 && low >= (limit - 1) / qValuation + 1))
+    {
+        return;
+    } // End if
+    if (level == 0)
+    {
+        result.push_back(Node<ItemType>(p[first].getCoefficient(), 0)); // The only power in the block is low itself
+        return;
+    } // End if
+
+    // Terms are sorted from highest to lowest, so the high half comes first
+    const size_t middle = low + (static_cast<size_t>(1) << (level - 1));
+    size_t split = first;
+    while (split < last && p[split].getPower() >= middle)
+    {
+        split++;
+    } // End while
+
+    std::vector<Node<ItemType>> high;
+    composeSparse(p, first, split, middle, level - 1, powers, limit, qValuation, buffers, high);
+    composeSparse(p, split, last, low, level - 1, powers, limit, qValuation, buffers, result);
+    if (high.empty() || powers[level - 1].empty())
+    {
+        return;
+    } // End if
+
+    std::vector<Node<ItemType>> product;
+    multiplyTerms(powers[level - 1], high, product, buffers, limit);
+
+    // Merge the product into the low half
+    std::vector<Node<ItemType>> merged;
+    merged.reserve(result.size() + product.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < product.size() && j < result.size())
+    {
+        if (product[i].getPower() == result[j].getPower())
+        {
+            ItemType sum = product[i].getCoefficient() + result[j].getCoefficient();
+            if (sum != 0)
             {
-                result.changeCoefficient(existCoefficient + newCoefficient, newPower);
+                merged.push_back(Node<ItemType>(sum, product[i].getPower()));
+            } // End if
+            i++;
+            j++;
+        }
+        else if (product[i].getPower() > result[j].getPower())
+        {
+            merged.push_back(product[i++]);
+        }
+        else
+        {
+            merged.push_back(result[j++]);
+        } // End if
+    } // End while
+    merged.insert(merged.end(), product.begin() + i, product.end());
+    merged.insert(merged.end(), result.begin() + j, result.end());
+    result.swap(merged);
+}  // End composeSparse
+
+// Builds the table of repeated squares of q and runs the matching divide and conquer
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::composeWithLimit(const SparsePoly<ItemType>& q, size_t limit) const
+{
+    SparsePoly<ItemType> result(q.variable);
+    if (headPtr == nullptr || limit == 0)
+    {
+        return result;
+    } // End if
+    if (q.headPtr == nullptr)
+    {
+        result.changeCoefficient(coefficient(0), 0); // p(0)
+        return result;
+    } // End if
+
+    const size_t length = static_cast<size_t>(headPtr->getPower()) + 1;
+    unsigned int levels = 0;
+    while ((static_cast<size_t>(1) << levels) < length)
+    {
+        levels++;
+    } // End while
+    std::vector<Node<ItemType>> qTerms = q.toVector();
+    const size_t qValuation = qTerms.back().getPower();
+    const size_t qLength = static_cast<size_t>(qTerms.front().getPower()) + 1;
+
+    if (static_cast<size_t>(termCount) * 4 >= length && qTerms.size() * 4 >= qLength)
+    {
+        // Both dense, compose on coefficient vectors with the Karatsuba kernel
+        std::vector<std::vector<ItemType>> powers(levels);
+        for (unsigned int k = 0; k < levels; k++)
+        {
+            if (qValuation > 0 && (static_cast<size_t>(1) << k) >= (limit - 1) / qValuation + 1)
+            {
+                break; // q^(2^k) and every later square lie entirely above the limit and stay empty
+            } // End if
+            if (k == 0)
+            {
+                powers[0] = q.toDenseCoefficients();
+                if (powers[0].size() > limit)
+                {
+                    powers[0].resize(limit);
+                } // End if
             }
             else
             {
-                result.changeCoefficient(newCoefficient, newPower);
-            }
-            otherPtr = otherPtr->getNext();
-        } // End while
-        thisPtr = thisPtr->getNext();
+                PolyKernels<ItemType>::multiplyTruncatedInto(powers[k - 1], powers[k - 1], limit, powers[k]);
+            } // End if
+        } // End for
+        std::vector<ItemType> composed;
+        composeDense(toDenseCoefficients(), 0, levels, powers, limit, qValuation, composed);
+        result.assignDenseCoefficients(composed);
+        return result;
+    } // End if
+
+    // Sparse, compose on sorted term vectors
+    MultiplyBuffers buffers;
+    std::vector<std::vector<Node<ItemType>>> powers(levels);
+    for (unsigned int k = 0; k < levels; k++)
+    {
+        if (qValuation > 0 && (static_cast<size_t>(1) << k) >= (limit - 1) / qValuation + 1)
+        {
+            break;
+        } // End if
+        if (k == 0)
+        {
+            // Multiplying by the single term 1 copies q without the terms at or above the limit
+            multiplyTerms(qTerms, std::vector<Node<ItemType>>(1, Node<ItemType>(static_cast<ItemType>(1), 0)), powers[0], buffers, limit);
+        }
+        else
+        {
+            multiplyTerms(powers[k - 1], powers[k - 1], powers[k], buffers, limit);
+        } // End if
+    } // End for
+    std::vector<Node<ItemType>> pTerms = toVector();
+    std::vector<Node<ItemType>> composed;
+    composeSparse(pTerms, 0, pTerms.size(), 0, levels, powers, limit, qValuation, buffers, composed);
+    result.assignTerms(composed);
+    return result;
+}  // End composeWithLimit
+
+// Computes p(q(x))
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::compose(const SparsePoly<ItemType>& q) const
+{
+    POLY_INSTRUMENT_OPERATION(Compose);
+    return composeWithLimit(q, static_cast<size_t>(-1));
+}  // End compose
+
+// Computes p(q(x)) up to a given degree
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::composeTruncated(const SparsePoly<ItemType>& q, unsigned int maxDegree) const
+{
+    POLY_INSTRUMENT_OPERATION(Compose);
+    return composeWithLimit(q, static_cast<size_t>(maxDegree) + 1);
+}  // End composeTruncated
+
+// Multiplies two polynomials as truncated power series
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::mulTrunc(const SparsePoly<ItemType>& anotherPoly, unsigned int n) const
+{
+    POLY_INSTRUMENT_OPERATION(MulTrunc);
+    SparsePoly<ItemType> result(variable);
+    if (variable != anotherPoly.variable)
+    {
+        return SparsePoly<ItemType>();
+    } // End if
+
+    std::vector<Node<ItemType>> product;
+    MultiplyBuffers buffers;
+    multiplyTerms(toVector(), anotherPoly.toVector(), product, buffers, static_cast<size_t>(n) + 1);
+    result.assignTerms(product);
+    return result;
+}  // End mulTrunc
+
+// Binary exponentiation with every product cut at degree n
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::powTrunc(unsigned int e, unsigned int n) const
+{
+    POLY_INSTRUMENT_OPERATION(PowTrunc);
+    SparsePoly<ItemType> result(variable);
+    const size_t limit = static_cast<size_t>(n) + 1;
+    std::vector<Node<ItemType>> accumulated(1, Node<ItemType>(static_cast<ItemType>(1), 0));
+    std::vector<Node<ItemType>> base = toVector();
+    std::vector<Node<ItemType>> scratch;
+    MultiplyBuffers buffers;
+
+    while (e > 0)
+    {
+        if (e & 1u)
+        {
+            multiplyTerms(accumulated, base, scratch, buffers, limit);
+            accumulated.swap(scratch);
+        } // End if
+        e >>= 1;
+        if (e > 0)
+        {
+            multiplyTerms(base, base, scratch, buffers, limit);
+            base.swap(scratch);
+        } // End if
     } // End while
-    thisPtr = nullptr;
-    otherPtr = nullptr;
+    result.assignTerms(accumulated);
     return result;
-} // End multiply
+}  // End powTrunc
+
+// Newton iteration for the power series inverse, doubling the precision each step
+template <class ItemType>
+SparsePoly<ItemType> SparsePoly<ItemType>::inverseTrunc(unsigned int n) const
+{
+    POLY_INSTRUMENT_OPERATION(InverseTrunc);
+    SparsePoly<ItemType> result(variable);
+    const ItemType constant = coefficient(0);
+    if (constant == 0)
+    {
+        return result;
+    } // End if
+
+    const size_t limit = static_cast<size_t>(n) + 1;
+    std::vector<ItemType> p = toDenseCoefficients();
+    if (p.size() > limit)
+    {
+        p.resize(limit);
+    } // End if
+    std::vector<ItemType> inverse(1, static_cast<ItemType>(1) / constant);
+    std::vector<ItemType> error;
+    std::vector<ItemType> upper;
+    std::vector<ItemType> correction;
+    size_t precision = 1;
+    while (precision < limit)
+    {
+        const size_t previous = precision;
+        precision = std::min(2 * precision, limit);
+
+        // p * g - 1 vanishes below the old precision, so only its upper half is multiplied by g, and the correction
+        // only fills the new coefficients of g, leaving the ones already found untouched
+        PolyKernels<ItemType>::multiplyTruncatedInto(p, inverse, precision, error);
+        error.resize(precision, static_cast<ItemType>(0));
+        upper.assign(error.begin() + previous, error.end());
+        PolyKernels<ItemType>::multiplyTruncatedInto(upper, inverse, precision - previous, correction);
+        inverse.resize(precision, static_cast<ItemType>(0));
+        for (size_t i = 0; i < correction.size(); i++)
+        {
+            inverse[previous + i] = -correction[i];
+        } // End for
+    } // End while
+    result.assignDenseCoefficients(inverse);
+    return result;
+}  // End inverseTrunc
 
 // Multiplies the polynomial by a scalar and returns a new polynomial object
 template <class ItemType>
 SparsePoly<ItemType> SparsePoly<ItemType>::scalarMultiply(ItemType scalar) const
 {
-    SparsePoly<ItemType> result;
+    POLY_INSTRUMENT_OPERATION(ScalarMultiply);
+    SparsePoly<ItemType> result(variable);
 
     // Pointer to the current polynomial
     Node<ItemType>* thisPtr = headPtr;
@@ -468,6 +1394,7 @@ SparsePoly<ItemType> SparsePoly<ItemType>::scalarMultiply(ItemType scalar) const
     // Traverse each term of current polynomial
     while (thisPtr != nullptr)
     {
+        POLY_INSTRUMENT_TRAVERSE(1);
         // Multiply the coefficient by the scalar
         ItemType newCoefficient = thisPtr->getCoefficient() * scalar;
 
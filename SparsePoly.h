@@ -1,18 +1,25 @@
 /** @file SparsePoly.h
 * @class SparsePoly
 * Class for an ordered sparse polynomial implementation including member functions to perform operations. Polynomial is ordered by power from highest to lowest.
+* Dispatch is static through SparsePolyBase; wrap the polynomial in SparsePolyAdapter to use it through SparsePolyInterface.
 */
 
 #ifndef SPARSE_POLY_
 #define SPARSE_POLY_
 
-#include "SparsePolyInterface.h"
+#include "SparsePolyBase.h"
 #include "Node.h"
+#include "PolyExpr.h"
+#include "PolyKernels.h"
+#include "PolyInstrumentation.h"
+#include "PolyFootprint.h"
+#include <cstdint>
+#include <functional>
 #include <vector>
 #include <string>
 
 template <class ItemType>
-class SparsePoly : public SparsePolyInterface<ItemType>
+class SparsePoly : public SparsePolyBase<SparsePoly<ItemType>, ItemType>
 {
 private:
 
@@ -25,6 +32,20 @@ private:
     /** Variable to hold the current number of terms in the node chain Polynomial. */
     int termCount;
 
+    /** Sum of hashTerm over every term, updated by each edit so that hash() takes constant time. */
+    std::uint64_t termHash;
+
+    /** Helper that mixes the bits of a 64 bit value so that nearby inputs give unrelated outputs.
+    * @param value The value to mix.
+    * @return The mixed value. */
+    static std::uint64_t mixHash(std::uint64_t value);
+
+    /** Helper that hashes one term. Terms are combined by adding their hashes, so a term can be added or taken out of termHash on its own.
+    * @param coefficient The coefficient of the term, hashed with std::hash.
+    * @param power The power of the term.
+    * @return The hash of the term. */
+    static std::uint64_t hashTerm(const ItemType& coefficient, unsigned int power);
+
     /** Helper member function to remove one term from the linked list. This is a private member function used to remove a term from the polynomial if a 0 coefficient is entered. This function will return memory to the heap for one term.
     * @pre Assumes nonnegative integer powers.
     * @post If successful, removes one term from the polynomial linked list.
@@ -45,6 +66,114 @@ private:
     * @return Returns a vector of Node type objects containing the polynomial. */
     std::vector<Node<ItemType>> toVector() const;
 
+    /** Run length from which a pair of runs of consecutive powers is multiplied with the dense kernel. */
+    static const size_t RUN_KERNEL_LENGTH = 8;
+
+    /** A run of consecutive powers in a sorted term vector. */
+    struct TermRun
+    {
+        size_t low;    // Lowest power in the run
+        size_t length; // Number of terms in the run
+        size_t offset; // Index of the run's lowest power coefficient in the run coefficient buffer
+    };
+
+    /** Scratch space reused across the multiplications performed by multiply, pow and powMod. */
+    struct MultiplyBuffers
+    {
+        std::vector<ItemType> left;
+        std::vector<ItemType> right;
+        std::vector<ItemType> product;
+        TermAccumulator<ItemType> pairs;
+        std::vector<TermRun> runsA;
+        std::vector<TermRun> runsB;
+        std::vector<ItemType> runCoefficientsA; // Coefficients of every run, each run lowest power first
+        std::vector<ItemType> runCoefficientsB;
+        std::vector<ItemType> runProduct;
+    };
+
+    /** Helper that splits sorted terms into runs of consecutive powers and copies each run's coefficients out lowest power first, ready for the dense kernel.
+    * @pre The terms are sorted by power from highest to lowest.
+    * @post runs lists the runs from the highest powers down and coefficients holds their coefficients.
+    * @param terms The terms.
+    * @param first Index of the first term to include.
+    * @param runs Receives the runs.
+    * @param coefficients Receives the coefficients of the runs. */
+    static void findRuns(const std::vector<Node<ItemType>>& terms, size_t first, std::vector<TermRun>& runs, std::vector<ItemType>& coefficients);
+
+    /** Helper for multiplyTerms that finds the runs of both operands and checks whether there are few enough of them to multiply run by run.
+    * @pre Both term vectors are sorted by power from highest to lowest.
+    * @post buffers holds the runs of both operands.
+    * @param a First term vector.
+    * @param firstA Index of the first term of a to include.
+    * @param b Second term vector.
+    * @param firstB Index of the first term of b to include.
+    * @param pairCount Number of pairs of terms in the product.
+    * @param buffers Receives the runs.
+    * @return True if the runs average at least RUN_KERNEL_LENGTH pairs of terms per pair of runs. */
+    static bool findRunsIfUseful(const std::vector<Node<ItemType>>& a, size_t firstA, const std::vector<Node<ItemType>>& b, size_t firstB,
+        size_t pairCount, MultiplyBuffers& buffers);
+
+    /** Helper for multiplyTerms that multiplies every pair of runs. Pairs of long runs go through the tiled vector kernel; short ones multiply term by term.
+    * @pre buffers holds the runs of both operands. With a dense product, buffers.product covers every power below limit that the product can reach.
+    * @post The products with powers below limit are added into buffers.product, or pushed into buffers.pairs when the product is not dense.
+    * @param buffers Scratch space holding the runs.
+    * @param limit One more than the highest power kept.
+    * @param dense Whether to accumulate into buffers.product rather than buffers.pairs. */
+    static void multiplyRuns(MultiplyBuffers& buffers, size_t limit, bool dense);
+
+    /** Helper function that multiplies two sorted term vectors. Dense operands use the Karatsuba kernel, products whose powers fall in a narrow range are accumulated into a dense array, and very sparse products are sorted and combined.
+    * In the last two cases, operands made of runs of consecutive powers are multiplied run by run with the dense kernel.
+    * With a limit, terms at or above it are skipped before multiplying and each row of pairs stops as soon as it reaches the limit, so no product term above the limit is formed.
+    * @pre Both term vectors are sorted by power from highest to lowest.
+    * @post product holds the sorted nonzero terms of the product with powers below limit.
+    * @param a The terms of the first operand.
+    * @param b The terms of the second operand.
+    * @param product Receives the terms of the product; must not be a or b.
+    * @param buffers Scratch space that keeps its capacity between calls.
+    * @param limit One more than the highest power kept, no limit by default. */
+    static void multiplyTerms(const std::vector<Node<ItemType>>& a, const std::vector<Node<ItemType>>& b,
+        std::vector<Node<ItemType>>& product, MultiplyBuffers& buffers, size_t limit = static_cast<size_t>(-1));
+
+    /** Helper for compose on dense coefficient vectors. Composes the block of p covering powers offset to offset + 2^level - 1 as low(q) + q^(2^(level-1)) * high(q).
+    * @pre powers[k] holds q^(2^k) cut to limit coefficients for every k below level.
+    * @post result holds the composed block as a dense vector with at most limit entries; empty means zero.
+    * @param p The dense coefficients of the outer polynomial.
+    * @param offset The lowest power of the block.
+    * @param level The block covers 2^level powers.
+    * @param powers The table of repeated squares of q.
+    * @param limit The number of coefficients kept, one more than the highest power kept.
+    * @param qValuation The lowest power of q; a block whose lowest power times qValuation reaches limit contributes nothing.
+    * @param result Receives the composed block. */
+    static void composeDense(const std::vector<ItemType>& p, size_t offset, unsigned int level,
+        const std::vector<std::vector<ItemType>>& powers, size_t limit, size_t qValuation, std::vector<ItemType>& result);
+
+    /** Helper for compose on sorted term vectors. Works like composeDense but only recurses into ranges that hold terms.
+    * @pre p[first, last) are the terms of p with powers from low to low + 2^level - 1, sorted from highest to lowest. powers[k] holds q^(2^k) for every k below level.
+    * @post result holds the sorted nonzero terms of the composed block with powers below limit.
+    * @param p The terms of the outer polynomial.
+    * @param first The first term of the block.
+    * @param last One past the last term of the block.
+    * @param low The lowest power of the block.
+    * @param level The block covers 2^level powers.
+    * @param powers The table of repeated squares of q.
+    * @param limit One more than the highest power kept.
+    * @param qValuation The lowest power of q.
+    * @param buffers Scratch space for the multiplications.
+    * @param result Receives the composed block. */
+    static void composeSparse(const std::vector<Node<ItemType>>& p, size_t first, size_t last, size_t low, unsigned int level,
+        const std::vector<std::vector<Node<ItemType>>>& powers, size_t limit, size_t qValuation, MultiplyBuffers& buffers,
+        std::vector<Node<ItemType>>& result);
+
+    /** Helper shared by compose and composeTruncated.
+    * @param q The inner polynomial.
+    * @param limit One more than the highest power kept.
+    * @return The polynomial p(q(x)) with powers below limit. */
+    SparsePoly<ItemType> composeWithLimit(const SparsePoly<ItemType>& q, size_t limit) const;
+
+    /** Products in expression templates multiply their combined operands with multiplyTerms. */
+    template <class Left, class Right>
+    friend class PolyProduct;
+
 public:
 
     /** Default constructor that uses 'x' as the variable. 
@@ -62,6 +191,40 @@ public:
     * @post None */
     SparsePoly(const SparsePoly<ItemType>& other);
 
+    /** Move constructor. Takes ownership of the other polynomial's node chain without copying.
+    * @pre None
+    * @post The other polynomial is left empty. */
+    SparsePoly(SparsePoly<ItemType>&& other) noexcept;
+
+    /** Constructs a polynomial by evaluating a lazy polynomial expression in one fused pass.
+    * @pre All polynomials referenced by the expression are still alive.
+    * @post The polynomial holds the result of the expression. Will be empty if the variables in the expression do not match.
+    * @param expr The expression built from the +, - and * operators. */
+    template <class Expr>
+    SparsePoly(const PolyExpr<Expr>& expr);
+
+    /** Deep copy assignment operator.
+    * @pre None
+    * @post The polynomial holds a copy of the other polynomial's terms and variable.
+    * @param other The polynomial to copy.
+    * @return A reference to this polynomial. */
+    SparsePoly<ItemType>& operator=(const SparsePoly<ItemType>& other);
+
+    /** Move assignment operator. Releases the current terms and takes ownership of the other polynomial's node chain.
+    * @pre None
+    * @post The other polynomial is left empty.
+    * @param other The polynomial to move from.
+    * @return A reference to this polynomial. */
+    SparsePoly<ItemType>& operator=(SparsePoly<ItemType>&& other) noexcept;
+
+    /** Assigns the result of a lazy polynomial expression, evaluated in one fused pass. The expression may refer to this polynomial.
+    * @pre All polynomials referenced by the expression are still alive.
+    * @post The polynomial holds the result of the expression. Will be empty if the variables in the expression do not match.
+    * @param expr The expression built from the +, - and * operators.
+    * @return A reference to this polynomial. */
+    template <class Expr>
+    SparsePoly<ItemType>& operator=(const PolyExpr<Expr>& expr);
+
     /** Updates a coefficient in the term of a given power. If the new coefficient is 0, the term will be removed. If the power of the new coefficient does not exist, a term will be created and placed in the correct sorted location. If the power of the new coefficient is already present, it will replace the current coefficient with the new one.
     * @pre Only nonnegative powers are accepted.
     * @post If successful, updates a term's coefficient with a new value, removes the term from the linked list, or adds a new term to the list depending on if the term already exists and if the new coefficient is 0.
@@ -73,7 +236,7 @@ public:
     /** Clears the polynomial, removing all terms and returning memory to the heap.
     * @pre None
     * @post headPtr will be pointing to nullptr and all memory is returned to the heap. */
-    void clear() final;
+    void clear();
 
     /** Retrieves the degree of the polynomial.
     * @pre None
@@ -100,6 +263,66 @@ public:
     * @return Will return a boolean value indicating if the polynomial contains any terms. */
     bool isEmpty() const;
 
+    /** Retrieves the variable character of the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The variable character. */
+    char getVariable() const;
+
+    /** Retrieves the number of terms in the polynomial.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The number of nonzero terms. */
+    int getTermCount() const;
+
+    /** Reports the memory used by the polynomial: the object itself and one heap node per term.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The footprint, with one heap block per term. */
+    PolyFootprint memoryFootprint() const;
+
+    /** Hashes the polynomial from its variable and terms. Equal polynomials have equal hashes.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The 64 bit hash, read from the hash that every edit keeps up to date. */
+    std::uint64_t hash() const;
+
+    /** Checks whether two polynomials have the same variable and terms. Polynomials with different term counts, degrees
+    * or hashes are told apart without walking the terms.
+    * @pre None
+    * @post Does not change either polynomial.
+    * @param other The polynomial to compare with.
+    * @return True if the variables match and every term matches. */
+    bool operator==(const SparsePoly<ItemType>& other) const;
+
+    /** @return True if the polynomials differ, see operator==. */
+    bool operator!=(const SparsePoly<ItemType>& other) const;
+
+    /** Visits every term from the highest to the lowest power without copying the node chain.
+    * @pre The visitor must not modify the polynomial.
+    * @post Does not change the polynomial.
+    * @param visit Callable invoked as visit(coefficient, power) for each term. */
+    template <class Visitor>
+    void forEachTerm(Visitor&& visit) const;
+
+    /** Replaces the polynomial with the given terms, building the node chain in a single pass.
+    * @pre Terms are sorted by power from highest to lowest with no repeated powers.
+    * @post The polynomial holds the nonzero terms of the vector; zero coefficients are skipped.
+    * @param sortedTerms The terms to store. */
+    void assignTerms(const std::vector<Node<ItemType>>& sortedTerms);
+
+    /** Copies the polynomial into a dense coefficient vector.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A vector where index i holds the coefficient of the term with power i, or an empty vector if the polynomial is empty. */
+    std::vector<ItemType> toDenseCoefficients() const;
+
+    /** Replaces the polynomial with the nonzero entries of a dense coefficient vector.
+    * @pre None
+    * @post The polynomial holds one term for each nonzero entry; the variable is unchanged.
+    * @param coefficients A vector where index i holds the coefficient of the term with power i. */
+    void assignDenseCoefficients(const std::vector<ItemType>& coefficients);
+
     /** Adds another polynomial to this polynomial and returns the result. 
     * @pre Both polynomials need to be sparse, contain the same variable, have the same coefficient type, and contain only nonnegative integer powers.
     * @post Does not change the original polynomial.
@@ -121,6 +344,59 @@ public:
     * @return A new polynomial resulting from multiplying the scalar. */
     SparsePoly<ItemType> scalarMultiply(ItemType scalar) const;
 
+    /** Raises the polynomial to a nonnegative integer power by binary exponentiation, reusing the multiplication buffers across squarings.
+    * @pre Powers in the result must fit in an unsigned int.
+    * @post Does not change the original polynomial.
+    * @param e The exponent.
+    * @return A new polynomial holding the polynomial to the power e. Raising any polynomial to the power 0 gives 1. */
+    SparsePoly<ItemType> pow(unsigned int e) const;
+
+    /** Raises the polynomial to a nonnegative integer power modulo another polynomial, reducing after every multiplication so intermediate results stay below the degree of the modulus.
+    * @pre Both polynomials contain the same variable. For integer coefficient types the leading coefficient of the modulus must divide exactly, for example 1 or -1; a coefficient type with exact division, such as integers modulo a prime, works with any modulus.
+    * @post Does not change the original polynomial.
+    * @param e The exponent.
+    * @param modulus The polynomial to reduce by.
+    * @return A new polynomial holding the remainder of the polynomial to the power e. Will return an empty polynomial if variables do not match or the modulus is empty. */
+    SparsePoly<ItemType> powMod(unsigned int e, const SparsePoly<ItemType>& modulus) const;
+
+    /** Substitutes another polynomial for the variable, computing p(q(x)). The terms of p are split in halves by power, so p(q) = low(q) + q^m * high(q), with the repeated squares q^(2^k) computed once and shared by every split. Dense inputs work on dense coefficient vectors; sparse inputs only recurse into ranges that hold terms.
+    * @pre The degree of p times the degree of q must fit in an unsigned int.
+    * @post Does not change either polynomial.
+    * @param q The polynomial substituted for the variable; its variable can differ from this polynomial's.
+    * @return A new polynomial in the variable of q. */
+    SparsePoly<ItemType> compose(const SparsePoly<ItemType>& q) const;
+
+    /** Computes p(q(x)) keeping only the terms up to a given degree. Powers of q and partial results are cut at maxDegree, and when q has no constant term, halves whose lowest power already pushes past maxDegree are skipped.
+    * @pre None
+    * @post Does not change either polynomial.
+    * @param q The polynomial substituted for the variable.
+    * @param maxDegree The highest power kept.
+    * @return A new polynomial in the variable of q holding the terms of p(q(x)) with power at most maxDegree. */
+    SparsePoly<ItemType> composeTruncated(const SparsePoly<ItemType>& q, unsigned int maxDegree) const;
+
+    /** Multiplies another polynomial with this polynomial as truncated power series, never forming a term above degree n.
+    * @pre Both polynomials contain the same variable.
+    * @post Does not change the original polynomial.
+    * @param anotherPoly Is the other polynomial.
+    * @param n The highest power kept.
+    * @return A new polynomial holding the terms of the product up to degree n. Will return an empty polynomial if variables do not match. */
+    SparsePoly<ItemType> mulTrunc(const SparsePoly<ItemType>& anotherPoly, unsigned int n) const;
+
+    /** Raises the polynomial to a nonnegative integer power as a truncated power series, cutting every squaring and multiplication at degree n.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param e The exponent.
+    * @param n The highest power kept.
+    * @return A new polynomial holding the terms of the polynomial to the power e up to degree n. */
+    SparsePoly<ItemType> powTrunc(unsigned int e, unsigned int n) const;
+
+    /** Computes the power series inverse 1 / p up to degree n with Newton iteration, g = g - g * (p * g - 1), doubling the number of correct terms each step.
+    * @pre For integer coefficient types the constant term must be 1 or -1 so the inverse stays exact.
+    * @post Does not change the original polynomial.
+    * @param n The highest power kept.
+    * @return A new polynomial g with p * g = 1 up to degree n. Will return an empty polynomial if the constant term is 0. */
+    SparsePoly<ItemType> inverseTrunc(unsigned int n) const;
+
     /** Evaluates the polynomial at a given value of the variable. 
     * @pre None
     * @post Does not change the original polynomial.
@@ -128,11 +404,52 @@ public:
     * @return The result of evaluating the polynomial at that value. */
     ItemType evaluate(ItemType x) const;
 
+    /** Evaluates the polynomial and its first k derivatives at a given value in one pass over the terms, as needed by Newton style solvers.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param x The value given for the variable.
+    * @param k The number of derivatives to evaluate.
+    * @return A vector of k + 1 values where entry j is the j-th derivative at x (entry 0 is the value of the polynomial). */
+    std::vector<ItemType> evaluateDerivatives(ItemType x, unsigned int k) const;
+
+    /** Computes the k-th derivative of the polynomial in one pass over the terms.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param k The order of the derivative, default is 1.
+    * @return A new polynomial holding the k-th derivative. */
+    SparsePoly<ItemType> derivative(unsigned int k = 1) const;
+
+    /** Computes the antiderivative of the polynomial with a constant term of 0 in one pass over the terms.
+    * @pre For integer coefficient types, each coefficient divided by its new power is truncated toward 0.
+    * @post Does not change the original polynomial.
+    * @return A new polynomial holding the integral, or an empty polynomial if a term has the largest unsigned int power. */
+    SparsePoly<ItemType> integral() const;
+
+    /** Computes p(x + a). Sparse inputs expand each term binomially; dense inputs use the divide and conquer kernel in PolyKernels.
+    * @pre None
+    * @post Does not change the original polynomial.
+    * @param a The amount to shift the variable by.
+    * @return A new polynomial holding the shifted polynomial. */
+    SparsePoly<ItemType> taylorShift(ItemType a) const;
+
     /** Destructor 
     * @pre None
     * @post None */
-    virtual ~SparsePoly();
+    ~SparsePoly();
 };
 
+namespace std
+{
+    /** Hashes a SparsePoly, so it can key unordered containers. */
+    template <class ItemType>
+    struct hash<SparsePoly<ItemType>>
+    {
+        size_t operator()(const SparsePoly<ItemType>& poly) const
+        {
+            return static_cast<size_t>(poly.hash());
+        }
+    }; // end hash
+} // end std
+
 #include "SparsePoly.cpp"
 #endif
\ No newline at end of file
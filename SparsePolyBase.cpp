@@ -0,0 +1,166 @@
+/** @file SparsePolyBase.cpp
+* Static interface for sparse polynomial backends and the adapter that exposes a backend through SparsePolyInterface.
+* @author Stephen Wagner
+* @date 10/13/2024
+* CSCI 591 Section 1
+*/
+
+#include "SparsePolyBase.h"
+
+// Destructor, instantiated once the backend is complete so the contract can be checked
+template <class Derived, class ItemType>
+SparsePolyBase<Derived, ItemType>::~SparsePolyBase()
+{
+    static_assert(IsSparsePolynomial<Derived>::value, "A SparsePolyBase backend must provide changeCoefficient, clear, degree, coefficient, displayPoly and isEmpty");
+}  // End destructor
+
+// Same format as SparsePoly::displayPoly, built from forEachTerm
+template <class Derived, class ItemType>
+std::string SparsePolyBase<Derived, ItemType>::formatTerms(char variable) const
+{
+    const Derived& backend = derived();
+    return formatTerms(variable, [&backend](auto&& visit) { backend.forEachTerm(visit); });
+}  // End formatTerms
+
+// Same format as SparsePoly::displayPoly, built from a term walker
+template <class Derived, class ItemType>
+template <class TermWalker>
+std::string SparsePolyBase<Derived, ItemType>::formatTerms(char variable, TermWalker&& walk)
+{
+    std::string polyString;
+    bool first = true;
+    walk([&](const ItemType& coefficient, unsigned int power)
+    {
+        if (!first)
+        {
+            polyString += " + ";
+        } // End if
+        first = false;
+        if (static_cast<ItemType>(1.0) != coefficient || power == 0)
+        {
+            polyString += "(" + std::to_string(coefficient) + ")";
+        }
+        else if (static_cast<ItemType>(-1.0) == coefficient)
+        {
+            polyString += "(-1)";
+        } // End if
+        if (power > 0)
+        {
+            polyString += variable;
+            if (power > 1)
+            {
+                polyString += "^" + std::to_string(power);
+            } // End if
+        } // End if
+    });
+    if (first)
+    {
+        return std::string("0");
+    } // End if
+    return polyString;
+}  // End formatTerms
+
+template <class Derived, class ItemType>
+Derived& SparsePolyBase<Derived, ItemType>::derived()
+{
+    return static_cast<Derived&>(*this);
+}  // End derived
+
+template <class Derived, class ItemType>
+const Derived& SparsePolyBase<Derived, ItemType>::derived() const
+{
+    return static_cast<const Derived&>(*this);
+}  // End derived
+
+// Returns the coefficient of the highest power term
+template <class Derived, class ItemType>
+ItemType SparsePolyBase<Derived, ItemType>::leadingCoefficient() const
+{
+    if (derived().isEmpty())
+    {
+        return 0;
+    } // End if
+    return derived().coefficient(derived().degree());
+}  // End leadingCoefficient
+
+// Compares two backends term by term
+template <class Derived, class ItemType>
+template <class OtherPoly>
+bool SparsePolyBase<Derived, ItemType>::hasSameTerms(const OtherPoly& other) const
+{
+    std::vector<std::pair<unsigned int, ItemType>> terms;
+    derived().forEachTerm([&](const ItemType& coefficient, unsigned int power)
+    {
+        terms.push_back(std::make_pair(power, coefficient));
+    });
+
+    size_t index = 0;
+    bool same = true;
+    other.forEachTerm([&](const ItemType& coefficient, unsigned int power)
+    {
+        if (!same || index >= terms.size() || terms[index].first != power || terms[index].second != coefficient)
+        {
+            same = false;
+        } // End if
+        index++;
+    });
+    return same && index == terms.size();
+}  // End hasSameTerms
+
+// Adapter default constructor
+template <class Poly>
+SparsePolyAdapter<Poly>::SparsePolyAdapter() : poly()
+{ }  // End default constructor
+
+// Adapter constructor wrapping a backend
+template <class Poly>
+SparsePolyAdapter<Poly>::SparsePolyAdapter(Poly somePoly) : poly(std::move(somePoly))
+{ }  // End constructor
+
+template <class Poly>
+Poly& SparsePolyAdapter<Poly>::get()
+{
+    return poly;
+}  // End get
+
+template <class Poly>
+const Poly& SparsePolyAdapter<Poly>::get() const
+{
+    return poly;
+}  // End get
+
+template <class Poly>
+int SparsePolyAdapter<Poly>::changeCoefficient(ItemType newCoefficient, unsigned int power)
+{
+    return poly.changeCoefficient(newCoefficient, power);
+}  // End changeCoefficient
+
+template <class Poly>
+void SparsePolyAdapter<Poly>::clear()
+{
+    poly.clear();
+}  // End clear
+
+template <class Poly>
+unsigned int SparsePolyAdapter<Poly>::degree() const
+{
+    return poly.degree();
+}  // End degree
+
+template <class Poly>
+typename Poly::value_type SparsePolyAdapter<Poly>::coefficient(unsigned int power) const
+{
+    return poly.coefficient(power);
+}  // End coefficient
+
+template <class Poly>
+std::string SparsePolyAdapter<Poly>::displayPoly() const
+{
+    return poly.displayPoly();
+}  // End displayPoly
+
+template <class Poly>
+bool SparsePolyAdapter<Poly>::isEmpty() const
+{
+    return poly.isEmpty();
+}  // End isEmpty
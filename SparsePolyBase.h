@@ -0,0 +1,161 @@
+/** @file SparsePolyBase.h
+* @class SparsePolyBase
+* Static (compile-time) interface for classes that hold a sparse polynomial. It has the same contract as
+* SparsePolyInterface (changeCoefficient, clear, degree, coefficient, displayPoly and isEmpty) but no virtual functions,
+* so backends carry no vtable pointer and calls on them inline fully. A backend derives from
+* SparsePolyBase<Backend, ItemType>, and generic code takes the backend as a template parameter, checked with
+* IsSparsePolynomial (or the SparsePolynomial concept under C++20). Code that needs runtime polymorphism wraps a backend
+* in SparsePolyAdapter, which implements SparsePolyInterface by forwarding to it.
+*/
+
+#ifndef SPARSE_POLY_BASE_
+#define SPARSE_POLY_BASE_
+
+#include "SparsePolyInterface.h"
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+#include <concepts>
+#endif
+
+/** Detects whether a type provides the sparse polynomial contract with the right signatures. */
+template <class Poly, class Enable = void>
+struct IsSparsePolynomial : std::false_type
+{
+}; // end IsSparsePolynomial
+
+template <class Poly>
+struct IsSparsePolynomial<Poly, typename std::enable_if<
+    std::is_convertible<decltype(std::declval<Poly&>().changeCoefficient(std::declval<typename Poly::value_type>(), 0u)), int>::value &&
+    std::is_same<decltype(std::declval<Poly&>().clear()), void>::value &&
+    std::is_convertible<decltype(std::declval<const Poly&>().degree()), unsigned int>::value &&
+    std::is_convertible<decltype(std::declval<const Poly&>().coefficient(0u)), typename Poly::value_type>::value &&
+    std::is_convertible<decltype(std::declval<const Poly&>().displayPoly()), std::string>::value &&
+    std::is_convertible<decltype(std::declval<const Poly&>().isEmpty()), bool>::value>::type> : std::true_type
+{
+}; // end IsSparsePolynomial
+
+#if defined(__cpp_concepts) && __cpp_concepts >= 201907L
+/** C++20 form of IsSparsePolynomial. */
+template <class Poly>
+concept SparsePolynomial = requires(Poly poly, const Poly constPoly, typename Poly::value_type coefficient, unsigned int power)
+{
+    { poly.changeCoefficient(coefficient, power) } -> std::convertible_to<int>;
+    { poly.clear() } -> std::same_as<void>;
+    { constPoly.degree() } -> std::convertible_to<unsigned int>;
+    { constPoly.coefficient(power) } -> std::convertible_to<typename Poly::value_type>;
+    { constPoly.displayPoly() } -> std::convertible_to<std::string>;
+    { constPoly.isEmpty() } -> std::convertible_to<bool>;
+};
+#endif
+
+template <class Derived, class ItemType>
+class SparsePolyBase
+{
+protected:
+    /** Only backends create the base.
+    * @pre None
+    * @post None */
+    SparsePolyBase() = default;
+
+    /** Non-virtual destructor; the base is never deleted through a pointer to it. Checks that the backend meets the contract.
+    * @pre None
+    * @post None */
+    ~SparsePolyBase();
+
+    /** Formats the terms of the backend the way SparsePoly::displayPoly does, for backends that have no faster way.
+    * @pre The backend provides forEachTerm.
+    * @post Does not change the polynomial.
+    * @param variable The variable character to print.
+    * @return The formatted polynomial, or '0' if it has no terms. */
+    std::string formatTerms(char variable) const;
+
+    /** Formats the terms a walker visits, for backends that must read the variable and the terms from one snapshot.
+    * @pre walk(visit) calls visit(coefficient, power) for each term, highest power first.
+    * @post None
+    * @param variable The variable character to print.
+    * @param walk The term walker.
+    * @return The formatted polynomial, or '0' if it has no terms. */
+    template <class TermWalker>
+    static std::string formatTerms(char variable, TermWalker&& walk);
+
+public:
+    using value_type = ItemType;
+
+    /** Gets the backend.
+    * @pre None
+    * @post None
+    * @return A reference to the derived polynomial. */
+    Derived& derived();
+
+    /** Gets the backend.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return A constant reference to the derived polynomial. */
+    const Derived& derived() const;
+
+    /** Retrieves the coefficient of the highest power term.
+    * @pre None
+    * @post Does not change the polynomial.
+    * @return The leading coefficient, or 0 if the polynomial is empty. */
+    ItemType leadingCoefficient() const;
+
+    /** Compares the terms of this polynomial with those of any other backend, one term at a time.
+    * @pre Both backends provide forEachTerm.
+    * @post Does not change either polynomial.
+    * @param other The polynomial to compare with.
+    * @return True if both hold exactly the same powers with the same coefficients. */
+    template <class OtherPoly>
+    bool hasSameTerms(const OtherPoly& other) const;
+}; // end SparsePolyBase
+
+/** Runtime polymorphic wrapper around a statically dispatched backend. Holds the backend by value and forwards every
+* SparsePolyInterface call to it. */
+template <class Poly>
+class SparsePolyAdapter : public SparsePolyInterface<typename Poly::value_type>
+{
+    static_assert(IsSparsePolynomial<Poly>::value, "SparsePolyAdapter requires a type meeting the sparse polynomial contract");
+
+private:
+    using ItemType = typename Poly::value_type;
+
+    /** The wrapped backend. */
+    Poly poly;
+
+public:
+    /** Default constructor
+    * @pre None
+    * @post Wraps an empty backend. */
+    SparsePolyAdapter();
+
+    /** Constructor that wraps a copy (or moved value) of a backend.
+    * @pre None
+    * @post None
+    * @param somePoly The backend to wrap. */
+    explicit SparsePolyAdapter(Poly somePoly);
+
+    /** Gets the wrapped backend for statically dispatched calls.
+    * @pre None
+    * @post None
+    * @return A reference to the backend. */
+    Poly& get();
+
+    /** Gets the wrapped backend for statically dispatched calls.
+    * @pre None
+    * @post None
+    * @return A constant reference to the backend. */
+    const Poly& get() const;
+
+    int changeCoefficient(ItemType newCoefficient, unsigned int power) override;
+    void clear() override;
+    unsigned int degree() const override;
+    ItemType coefficient(unsigned int power) const override;
+    std::string displayPoly() const override;
+    bool isEmpty() const override;
+}; // end SparsePolyAdapter
+
+#include "SparsePolyBase.cpp"
+#endif
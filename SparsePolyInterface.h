@@ -1,6 +1,7 @@
 /** @file SparsePolyInterface.h
 * @class SparsePolyInterface
-* Interface for classes that hold a sparse polynomial.
+* Interface for classes that hold a sparse polynomial. Backends such as SparsePoly implement the same contract statically
+* through SparsePolyBase; SparsePolyAdapter implements this interface for callers that need runtime polymorphism.
 */
 
 #ifndef SPARSE_POLY_INTERFACE_
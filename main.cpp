@@ -1,8 +1,31 @@
 #include <iostream>
 #include "SparsePoly.h"
+#include "SmallSparsePoly.h"
+#include "SharedSparsePoly.h"
+#include "PolyJobScheduler.h"
+#include "CompactPoly.h"
+#include "PolyDifferential.h"
+#include "PolyInterpolation.h"
+#include "PolyIntern.h"
+#include "BasisPoly.h"
+#include "CompiledPoly.h"
+#include <thread>
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include "PolyRoots.h"
 
 using namespace std;
 
+#ifdef POLY_JOB_COROUTINES
+// Coroutine job that waits for a polynomial job, then adds a term to it
+PolyTask<SparsePoly<int>> addWhenReady(PolyJob<SparsePoly<int>> previous, SparsePoly<int> term)
+{
+    SparsePoly<int> value = co_await previous;
+    co_return value.add(term);
+}
+#endif
+
 int main() 
 {
     cout << "__________Test Document : Testing SparsePoly__________" << endl;
@@ -139,6 +162,418 @@ int main()
     cout << "Evaluation should be: 11" << endl;
     cout << endl;
 
+    // Testing the runtime interface adapter
+    cout << "--Testing SparsePolyAdapter--" << endl;
+    SparsePolyAdapter<SparsePoly<int>> adapted(poly1); // The adapter holds its own copy of poly1
+    SparsePolyInterface<int>& runtimePoly = adapted;
+    runtimePoly.changeCoefficient(4, 1);
+    cout << "The adapter's copy of poly1 with 4x added through the interface is: " << runtimePoly.displayPoly() << endl;
+    cout << "Result should be: 3x^2 + 4x - 1" << endl;
+    cout << "poly1 is still: " << poly1.displayPoly() << endl;
+    cout << "Result should be: 3x^2 - 1" << endl;
+    cout << endl;
+
+    // Testing powers
+    cout << "--Testing pow() and powMod()--" << endl;
+    cout << "poly1 to the power 3 is: " << poly1.pow(3).displayPoly() << endl;
+    cout << "Result should be: 27x^6 - 27x^4 + 9x^2 - 1" << endl;
+    SparsePoly<int> modulus;
+    modulus.changeCoefficient(1, 4);
+    modulus.changeCoefficient(-1, 0);
+    cout << "poly1 to the power 3 modulo x^4 - 1 is: " << poly1.powMod(3, modulus).displayPoly() << endl;
+    cout << "Result should be: 36x^2 - 28" << endl;
+    cout << endl;
+
+    // Testing lazy expression operators
+    cout << "--Testing expression operators--" << endl;
+    SparsePoly<int> poly8 = (poly1 + poly2) * poly1 * 2;
+    cout << "(poly1 + poly2) * poly1 * 2 is: " << poly8.displayPoly() << endl;
+    cout << "Result should be: 60x^4 - 14x^2 - 2" << endl;
+    cout << "(poly1 - poly2) evaluated at 2 is: " << (poly1 - poly2)(2) << endl;
+    cout << "Evaluation should be: -19" << endl;
+    cout << endl;
+
+    // Testing derivative, integral and Taylor shift
+    cout << "--Testing derivative(), integral() and taylorShift()--" << endl;
+    cout << "Derivative of poly3 is: " << poly3.derivative().displayPoly() << endl;
+    cout << "Result should be: 28.7x^4 + 7.37271x^2" << endl;
+    cout << "Integral of poly1 is: " << poly1.integral().displayPoly() << endl;
+    cout << "Result should be: x^3 - x" << endl;
+    cout << "poly1 shifted by 1 is: " << poly1.taylorShift(1).displayPoly() << endl;
+    cout << "Result should be: 3x^2 + 6x + 2" << endl;
+    vector<double> derivatives = poly3.evaluateDerivatives(1.0, 2);
+    cout << "poly3 and its first two derivatives at 1 are: " << derivatives[0] << ", " << derivatives[1] << ", " << derivatives[2] << endl;
+    cout << "Results should be: 9.19757, 36.0727, 129.545" << endl;
+    cout << endl;
+
+    // Testing real root finding
+    cout << "--Testing PolyRoots::realRoots()--" << endl;
+    SparsePoly<double> poly9;
+    poly9.changeCoefficient(1.0, 3);
+    poly9.changeCoefficient(-2.0, 2);
+    poly9.changeCoefficient(-1.0, 1);
+    poly9.changeCoefficient(2.0, 0);
+    cout << "poly9: " << poly9.displayPoly() << endl;
+    vector<double> roots = PolyRoots<double>::realRoots(poly9);
+    cout << "Real roots of poly9 are:";
+    for (double root : roots)
+    {
+        cout << " " << root;
+    }
+    cout << endl;
+    cout << "Roots should be: -1 1 2" << endl;
+
+    // Repeated roots are reported once
+    SparsePoly<double> doubleRoot;
+    doubleRoot.changeCoefficient(1.0, 2);
+    doubleRoot.changeCoefficient(-2.0, 1);
+    doubleRoot.changeCoefficient(1.0, 0);
+    SparsePoly<double> plusTwo;
+    plusTwo.changeCoefficient(1.0, 1);
+    plusTwo.changeCoefficient(2.0, 0);
+    SparsePoly<double> minusFive;
+    minusFive.changeCoefficient(1.0, 1);
+    minusFive.changeCoefficient(-5.0, 0);
+    SparsePoly<double> minusTwoSquared;
+    minusTwoSquared.changeCoefficient(1.0, 2);
+    minusTwoSquared.changeCoefficient(-4.0, 1);
+    minusTwoSquared.changeCoefficient(4.0, 0);
+    vector<SparsePoly<double>> repeated = { doubleRoot, doubleRoot.multiply(plusTwo), minusTwoSquared.multiply(minusFive) };
+    vector<vector<double>> repeatedRoots = PolyRoots<double>::realRootsBatch(repeated, 2);
+    cout << "Real roots of (x - 1)^2, (x - 1)^2 (x + 2) and (x - 2)^2 (x - 5) are:";
+    for (const vector<double>& polyRoots : repeatedRoots)
+    {
+        cout << " |";
+        for (double root : polyRoots)
+        {
+            cout << " " << root;
+        } // End for
+    } // End for
+    cout << endl;
+    cout << "Roots should be: | 1 | -2 1 | 2 5" << endl;
+    cout << endl;
+
+    // Testing the small-buffer backend
+    cout << "--Testing SmallSparsePoly--" << endl;
+    SmallSparsePoly<int, 2> smallPoly(poly1);
+    cout << "smallPoly copied from poly1: " << smallPoly.displayPoly() << (smallPoly.isInline() ? " (inline)" : " (heap)") << endl;
+    smallPoly.changeCoefficient(4, 5);
+    cout << "After adding 4x^5: " << smallPoly.displayPoly() << (smallPoly.isInline() ? " (inline)" : " (heap)") << endl;
+    cout << "Result should be: 4x^5 + 3x^2 - 1 (heap)" << endl;
+    cout << "smallPoly + smallPoly is: " << smallPoly.add(smallPoly).displayPoly() << endl;
+    cout << "smallPoly evaluated at 2 is: " << smallPoly.evaluate(2) << endl;
+    cout << "Result should be: 139" << endl;
+    cout << "Round trip through SparsePoly keeps the terms: " << (smallPoly.toSparsePoly().hasSameTerms(smallPoly) ? "Yes" : "No") << endl;
+    SmallSparsePoly<int, 2> smallLinear;
+    smallLinear.changeCoefficient(2, 1);
+    smallLinear.changeCoefficient(1, 0);
+    SmallSparsePoly<int, 2> smallSum = smallLinear.add(smallLinear);
+    cout << "(2x + 1) + (2x + 1) is: " << smallSum.displayPoly() << (smallSum.isInline() ? " (inline)" : " (heap)") << endl;
+    cout << "Result should be: 4x + 2 (inline)" << endl;
+    cout << endl;
+
+    // Testing the shared polynomial with lock-free readers
+    cout << "--Testing SharedSparsePoly--" << endl;
+    SharedSparsePoly<int> sharedPoly(poly1);
+    cout << "sharedPoly published from poly1: " << sharedPoly.displayPoly() << " (version " << sharedPoly.getVersion() << ")" << endl;
+    int readerValue = 0;
+    thread reader([&sharedPoly, &readerValue]() { readerValue = sharedPoly.evaluate(2); });
+    sharedPoly.changeCoefficient(7, 4);
+    reader.join();
+    cout << "Reader running alongside the update saw either 11 or 123: " << ((readerValue == 11 || readerValue == 123) ? "Yes" : "No") << endl;
+    cout << "sharedPoly after adding 7x^4: " << sharedPoly.displayPoly() << " (version " << sharedPoly.getVersion() << ")" << endl;
+    cout << "Result should be: 7x^4 + 3x^2 - 1 (version 2)" << endl;
+    SparsePoly<int> linearX;
+    linearX.changeCoefficient(1, 1);
+    SparsePoly<int> squareY('y');
+    squareY.changeCoefficient(2, 2);
+    SharedSparsePoly<int> switching(linearX);
+    std::atomic<bool> writing(true);
+    std::atomic<int> tornReads(0);
+    vector<thread> displayReaders;
+    for (int i = 0; i < 3; i++)
+    {
+        displayReaders.emplace_back([&switching, &writing, &tornReads]()
+        {
+            while (writing.load())
+            {
+                string shown = switching.displayPoly();
+                if (shown != "x" && shown != "(2)y^2")
+                {
+                    tornReads++;
+                } // End if
+            } // End while
+        });
+    } // End for
+    for (int i = 0; i < 20000; i++)
+    {
+        switching.assign((i % 2 == 0) ? squareY : linearX);
+    } // End for
+    writing = false;
+    for (thread& displayReader : displayReaders)
+    {
+        displayReader.join();
+    } // End for
+    cout << "Readers displaying while the variable switches between x and y saw only published versions: " << (tornReads == 0 ? "Yes" : "No") << endl;
+    cout << "Result should be: Yes" << endl;
+    cout << endl;
+
+    // Testing composition
+    cout << "--Testing compose() and composeTruncated()--" << endl;
+    SparsePoly<int> inner;
+    inner.changeCoefficient(1, 1);
+    inner.changeCoefficient(1, 0);
+    cout << "poly1(x + 1) is: " << poly1.compose(inner).displayPoly() << endl;
+    cout << "Result should be: 3x^2 + 6x + 2" << endl;
+    cout << "poly1(x + 1) up to degree 1 is: " << poly1.composeTruncated(inner, 1).displayPoly() << endl;
+    cout << "Result should be: 6x + 2" << endl;
+    cout << endl;
+
+    // Testing truncated power series
+    cout << "--Testing mulTrunc(), powTrunc() and inverseTrunc()--" << endl;
+    cout << "(x + 1)^5 up to degree 2 is: " << inner.powTrunc(5, 2).displayPoly() << endl;
+    cout << "Result should be: 10x^2 + 5x + 1" << endl;
+    SparsePoly<int> series;
+    series.changeCoefficient(1, 0);
+    series.changeCoefficient(-1, 1);
+    cout << "1 / (1 - x) up to degree 4 is: " << series.inverseTrunc(4).displayPoly() << endl;
+    cout << "Result should be: x^4 + x^3 + x^2 + x + 1" << endl;
+    cout << "(1 - x) * (x + 1) up to degree 1 is: " << series.mulTrunc(inner, 1).displayPoly() << endl;
+    cout << "Result should be: 1" << endl;
+    cout << endl;
+
+    // Testing the job scheduler
+    cout << "--Testing PolyJobScheduler--" << endl;
+    {
+        PolyJobScheduler scheduler(2);
+        PolyJob<SparsePoly<int>> job1 = scheduler.ready(poly1);
+        PolyJob<SparsePoly<int>> jobInner = scheduler.ready(inner);
+        PolyJob<SparsePoly<int>> jobProduct = scheduler.multiply(job1, jobInner);
+        PolyJob<SparsePoly<int>> jobSum = scheduler.add(jobProduct, job1);
+        PolyJob<int> atOne = scheduler.evaluate(jobSum, 1);
+        PolyJob<int> atTwo = scheduler.evaluate(jobSum, 2);
+        cout << "poly1 * (x + 1) + poly1 is: " << scheduler.display(jobSum).get() << endl;
+        cout << "Result should be: 3x^3 + 6x^2 - x - 2" << endl;
+        cout << "Evaluated at 1 and 2: " << atOne.get() << ", " << atTwo.get() << endl;
+        cout << "Results should be: 6, 44" << endl;
+
+        vector<PolyJob<int>> fused;
+        for (int x = 0; x < 20; x++)
+        {
+            fused.push_back(scheduler.evaluate(jobSum, x));
+        } // End for
+        bool fusedMatch = true;
+        for (int x = 0; x < 20; x++)
+        {
+            fusedMatch = fusedMatch && fused[x].get() == jobSum.get().evaluate(x);
+        } // End for
+        cout << "20 evaluations queued together match evaluate(): " << (fusedMatch ? "Yes" : "No") << endl;
+        cout << "Result should be: Yes" << endl;
+
+        PolyJob<SparsePoly<int>> failing = scheduler.submit([](const SparsePoly<int>&) -> SparsePoly<int>
+        {
+            throw runtime_error("job failed");
+        }, job1);
+        PolyJob<SparsePoly<int>> afterFailure = scheduler.add(failing, job1);
+        try
+        {
+            afterFailure.get();
+            cout << "A job depending on a failed job rethrows: No" << endl;
+        }
+        catch (const runtime_error& error)
+        {
+            cout << "A job depending on a failed job rethrows: " << error.what() << endl;
+        } // End try
+        cout << "Result should be: job failed" << endl;
+
+#ifdef POLY_JOB_COROUTINES
+        PolyJob<SparsePoly<int>> chain = scheduler.ready(SparsePoly<int>());
+        for (int i = 0; i < 50; i++)
+        {
+            chain = scheduler.spawn(addWhenReady(chain, inner));
+        } // End for
+        cout << "50 spawned coroutines each adding x + 1: " << chain.get().displayPoly() << endl;
+        cout << "Result should be: 50x + 50" << endl;
+        PolyJob<SparsePoly<int>> awaitedFailure = scheduler.spawn(addWhenReady(failing, inner));
+        try
+        {
+            awaitedFailure.get();
+            cout << "A coroutine awaiting a failed job rethrows: No" << endl;
+        }
+        catch (const runtime_error& error)
+        {
+            cout << "A coroutine awaiting a failed job rethrows: " << error.what() << endl;
+        } // End try
+        cout << "Result should be: job failed" << endl;
+#else
+        cout << "Coroutine jobs need C++20; spawn is not available in this build" << endl;
+#endif
+    }
+    cout << endl;
+
+    // Testing memory footprints and compaction
+    cout << "--Testing memoryFootprint() and CompactPoly--" << endl;
+    SparsePoly<int> densePoly;
+    for (unsigned int power = 0; power < 100; power++)
+    {
+        densePoly.changeCoefficient(static_cast<int>(power % 10) + 1, power);
+    } // End for
+    CompactPoly<int> compactPoly(densePoly);
+    cout << "Coefficient width after compaction: " << compactPoly.getCoefficientWidth() << " byte" << endl;
+    cout << "Result should be: 1 byte" << endl;
+    cout << "Compact form is smaller: " << ((compactPoly.memoryFootprint().totalBytes() < densePoly.memoryFootprint().totalBytes()) ? "Yes" : "No") << endl;
+    cout << "Result should be: Yes" << endl;
+    cout << "Coefficient of x^57 and value at 1: " << compactPoly.coefficient(57) << ", " << compactPoly.evaluate(1) << endl;
+    cout << "Results should be: 8, 550" << endl;
+    vector<SparsePoly<int>> polySet(3, poly1);
+    cout << "Heap blocks of three copies of poly1: " << memoryFootprint(polySet).heapBlocks << endl;
+    cout << "Result should be: 7" << endl;
+    cout << endl;
+
+    // Testing interpolation
+    cout << "--Testing PolyInterpolation--" << endl;
+    vector<double> samplePoints = { 0, 1, 2 };
+    SparsePoly<double> throughPoints = PolyInterpolation<double>::interpolateFunction([](double x) { return 3 * x * x - 1; }, samplePoints, 2);
+    cout << "Polynomial through (0, -1), (1, 2), (2, 11): " << throughPoints.displayPoly() << endl;
+    cout << "Result should be: (3.000000)x^2 + (-1.000000)" << endl;
+    vector<double> chebyshevPoints;
+    for (int i = 0; i < 32; i++)
+    {
+        chebyshevPoints.push_back(cos(acos(-1.0) * (2 * i + 1) / 64));
+    } // End for
+    auto tenth = [](double x) { return 3 * pow(x, 10) - 2 * x * x + 1; };
+    SparsePoly<double> throughChebyshev = PolyInterpolation<double>::interpolateFunction(tenth, chebyshevPoints, 2);
+    double worstResidual = 0;
+    for (double point : chebyshevPoints)
+    {
+        worstResidual = max(worstResidual, fabs(throughChebyshev.evaluate(point) - tenth(point)));
+    } // End for
+    cout << "Through 32 Chebyshev points of 3x^10 - 2x^2 + 1, residual below 1e-12, x^10 and x^2 coefficients: "
+        << (worstResidual < 1e-12 ? "Yes" : "No") << ", " << round(throughChebyshev.coefficient(10) * 1e6) / 1e6 << ", "
+        << round(throughChebyshev.coefficient(2) * 1e6) / 1e6 << endl;
+    cout << "Results should be: Yes, 3, -2" << endl;
+    SparsePoly<long long> hidden;
+    hidden.changeCoefficient(5, 1000000);
+    hidden.changeCoefficient(-2, 3);
+    hidden.changeCoefficient(7, 0);
+    auto blackBox = [&hidden](std::uint64_t x) { return PolyInterpolation<long long>::evaluateModular(hidden, x); };
+    cout << "Sparse polynomial recovered from 8 samples: " << PolyInterpolation<long long>::interpolateSparse(blackBox, 4, 2).displayPoly() << endl;
+    cout << "Result should be: (5)x^1000000 + (-2)x^3 + (7)" << endl;
+    cout << endl;
+
+    // Testing every backend against the reference model
+    cout << "--Testing PolyDifferential--" << endl;
+    string differentialFailure = PolyDifferential::check(1, 200, 40);
+    cout << "All backends agree with the reference over 200 random runs: " << (differentialFailure.empty() ? "Yes" : "No\n" + differentialFailure) << endl;
+    cout << "Result should be: Yes" << endl;
+    cout << endl;
+
+    // Testing runs of consecutive powers, which multiply on the dense vector kernel
+    cout << "--Testing run multiplication--" << endl;
+    SparsePoly<long long> runs;
+    SparsePoly<long long> ones;
+    for (unsigned int k = 0; k < 16; k++)
+    {
+        runs.changeCoefficient(1, k);
+        runs.changeCoefficient(2, 100 + k);
+        ones.changeCoefficient(1, k);
+    } // End for
+    SparsePoly<long long> runProduct = runs.multiply(ones);
+    cout << "Degree and coefficients of x^15 and x^115: " << runProduct.degree() << ", " << runProduct.coefficient(15) << ", " << runProduct.coefficient(115) << endl;
+    cout << "Results should be: 130, 16, 32" << endl;
+    cout << endl;
+
+    // Testing equality, hashing and interning
+    cout << "--Testing equality and PolyInternTable--" << endl;
+    SparsePoly<int> builtUp;
+    builtUp.changeCoefficient(4, 1);
+    builtUp.changeCoefficient(9, 7);
+    builtUp.changeCoefficient(2, 3);
+    builtUp.changeCoefficient(5, 0);
+    builtUp.changeCoefficient(0, 3);
+    SparsePoly<int> builtDown;
+    builtDown.changeCoefficient(9, 7);
+    builtDown.changeCoefficient(4, 1);
+    builtDown.changeCoefficient(5, 0);
+    cout << "Equal after different edits, same hash: " << (builtUp == builtDown ? "Yes" : "No") << ", " << (builtUp.hash() == builtDown.hash() ? "Yes" : "No") << endl;
+    cout << "Results should be: Yes, Yes" << endl;
+    PolyInternTable<int> internTable;
+    bool sameCopy = internTable.intern(builtUp) == internTable.intern(builtDown);
+    internTable.intern(builtUp.scalarMultiply(2));
+    cout << "Interned copies shared, distinct polynomials stored: " << (sameCopy ? "Yes" : "No") << ", " << internTable.size() << endl;
+    cout << "Results should be: Yes, 2" << endl;
+    cout << endl;
+
+    // Testing Chebyshev, Legendre and Newton bases
+    cout << "--Testing BasisPoly--" << endl;
+    SparsePoly<double> monomial;
+    monomial.changeCoefficient(4, 3);
+    monomial.changeCoefficient(-3, 1);
+    monomial.changeCoefficient(2, 0);
+    BasisPoly<double> chebyshev = BasisPoly<double>::fromMonomial(monomial, PolyBasis::Chebyshev);
+    cout << "4x^3 - 3x + 2 in the Chebyshev basis: " << chebyshev.displayPoly() << endl;
+    cout << "Result should be: (1.000000)T_3(x) + (2.000000)T_0(x)" << endl;
+    vector<double> basisPoints = { 0.5, -1 };
+    vector<double> basisValues = chebyshev.evaluateMany(basisPoints);
+    cout << "Values at 0.5 and -1: " << basisValues[0] << ", " << basisValues[1] << endl;
+    cout << "Results should be: 1, 1" << endl;
+    BasisPoly<double> legendre(PolyBasis::Legendre, vector<double>{ 1, 0, 3 });
+    cout << "P_0 + 3 P_2 in monomial form: " << legendre.toMonomial().displayPoly() << endl;
+    cout << "Result should be: (4.500000)x^2 + (-0.500000)" << endl;
+    cout << "Derivative of T_3 + 2 T_0: " << chebyshev.derivative().displayPoly() << endl;
+    cout << "Result should be: (6.000000)T_2(x) + (3.000000)T_0(x)" << endl;
+    cout << endl;
+
+    // Testing compiled evaluators
+    cout << "--Testing CompiledPoly--" << endl;
+    SparsePoly<double> denseQuadratic;
+    denseQuadratic.changeCoefficient(3, 2);
+    denseQuadratic.changeCoefficient(2, 1);
+    denseQuadratic.changeCoefficient(1, 0);
+    CompiledPoly<double> compiledDense = CompiledPoly<double>::compile(denseQuadratic);
+    cout << "3x^2 + 2x + 1 at 2, dense: " << compiledDense.evaluate(2) << ", " << (compiledDense.getShape() == CompiledShape::Dense ? "Yes" : "No") << endl;
+    cout << "Results should be: 17, Yes" << endl;
+    SparsePoly<double> evenQuartic;
+    evenQuartic.changeCoefficient(1, 4);
+    evenQuartic.changeCoefficient(1, 2);
+    CompiledPoly<double> compiledEven = CompiledPoly<double>::compile(evenQuartic);
+    cout << "x^4 + x^2 at 2, stride: " << compiledEven.evaluate(2) << ", " << compiledEven.getStride() << endl;
+    cout << "Results should be: 20, 2" << endl;
+    SparsePoly<double> sparseHigh;
+    sparseHigh.changeCoefficient(1, 100);
+    sparseHigh.changeCoefficient(1, 7);
+    sparseHigh.changeCoefficient(-1, 1);
+    CompiledPoly<double> compiledSparse = CompiledPoly<double>::compile(sparseHigh);
+    cout << "x^100 + x^7 - x at 1, sparse: " << compiledSparse.evaluate(1) << ", " << (compiledSparse.getShape() == CompiledShape::Sparse ? "Yes" : "No") << endl;
+    cout << "Results should be: 1, Yes" << endl;
+    cout << endl;
+
+    // Testing operation counters
+    cout << "--Testing PolyInstrumentation--" << endl;
+    PolyInstrumentation::reset();
+    SparsePoly<int> counted;
+    counted.changeCoefficient(2, 1);
+    counted.changeCoefficient(1, 0);
+    SparsePoly<int> countedSquare = counted.multiply(counted);
+    PolyCountersSnapshot counters = PolyInstrumentation::snapshot();
+    cout << "(2x + 1)^2: " << countedSquare.displayPoly() << endl;
+    cout << "Result should be: (4)x^2 + (4)x + (1)" << endl;
+    cout << "changeCoefficient calls and nodes allocated, multiply calls, nodes allocated for the product: "
+        << counters.get(PolyOperation::ChangeCoefficient, PolyMetric::Calls) << ", "
+        << counters.get(PolyOperation::ChangeCoefficient, PolyMetric::NodesAllocated) << ", "
+        << counters.get(PolyOperation::Multiply, PolyMetric::Calls) << ", "
+        << counters.get(PolyOperation::AssignTerms, PolyMetric::NodesAllocated) << endl;
+#ifdef SPARSE_POLY_INSTRUMENTATION
+    cout << "Results should be: 2, 2, 1, 3" << endl;
+    cout << "JSON: " << counters.toJson() << endl;
+    cout << "Prometheus:" << endl << counters.toPrometheus();
+#else
+    cout << "Results should be: 0, 0, 0, 0 (built without SPARSE_POLY_INSTRUMENTATION)" << endl;
+    cout << "JSON: " << counters.toJson() << endl;
+    cout << "Result should be: {}" << endl;
+#endif
+    cout << endl;
+
     cout << "=====Boundary Values=====" << endl;
     cout << endl;
 
@@ -224,6 +659,12 @@ int main()
     poly1.changeCoefficient(2, -5);
     cout << poly1.displayPoly() << endl; // Showing the results of that test
     cout << "Result should be: 2x^2" << endl;
+
+    // Trying to integrate a term at the largest power
+    SparsePoly<int> polyTop;
+    polyTop.changeCoefficient(3, -1);
+    cout << polyTop.integral().displayPoly() << endl;
+    cout << "Result should be: 0" << endl;
     cout << endl;
 
     cout << "--Testing math operations with different variables--" << endl;